@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/fitted_attribute_vector.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/performance_warning.hpp"
+
+/**
+ * Measures how many rows per second the DictionarySegment constructor encodes, compared to the previous
+ * implementation that deduplicated through a std::set and looked up every row through the virtual operator[].
+ *
+ * Usage: hyriseDictionaryEncodingBenchmark [row_count]
+ */
+
+namespace opossum {
+
+namespace {
+
+// The encoder that DictionarySegment used before, kept here as the baseline
+template <typename T>
+std::shared_ptr<BaseAttributeVector> legacy_encode(const std::shared_ptr<BaseSegment>& base_segment,
+                                                   std::vector<T>& dictionary) {
+  const auto& value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+
+  std::set<T> deduplicated_set(value_segment->values().cbegin(), value_segment->values().cend());
+  dictionary.assign(deduplicated_set.cbegin(), deduplicated_set.cend());
+
+  std::shared_ptr<BaseAttributeVector> attribute_vector;
+  if (dictionary.size() <= std::numeric_limits<uint8_t>::max()) {
+    attribute_vector = std::make_shared<FittedAttributeVector<uint8_t>>(base_segment->size());
+  } else if (dictionary.size() <= std::numeric_limits<uint16_t>::max()) {
+    attribute_vector = std::make_shared<FittedAttributeVector<uint16_t>>(base_segment->size());
+  } else {
+    attribute_vector = std::make_shared<FittedAttributeVector<uint32_t>>(base_segment->size());
+  }
+
+  std::sort(dictionary.begin(), dictionary.end());
+
+  for (size_t segment_idx = 0; segment_idx < base_segment->size(); ++segment_idx) {
+    const auto& dict_it =
+        std::lower_bound(dictionary.cbegin(), dictionary.cend(), type_cast<T>((*value_segment)[segment_idx]));
+    if (dict_it != dictionary.cend()) {
+      attribute_vector->set(segment_idx, ValueID{static_cast<ValueID::base_type>(dict_it - dictionary.cbegin())});
+    }
+  }
+  return attribute_vector;
+}
+
+// Returns the best of three runs in seconds
+template <typename Functor>
+double measure(const Functor& functor) {
+  auto best = std::numeric_limits<double>::max();
+  for (auto run = 0; run < 3; ++run) {
+    const auto begin = std::chrono::steady_clock::now();
+    functor();
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - begin).count());
+  }
+  return best;
+}
+
+template <typename T>
+void benchmark(const std::string& name, const std::shared_ptr<ValueSegment<T>>& value_segment) {
+  const auto legacy_seconds = measure([&]() {
+    auto dictionary = std::vector<T>{};
+    legacy_encode<T>(value_segment, dictionary);
+  });
+  const auto seconds = measure([&]() { DictionarySegment<T>{value_segment}; });
+
+  const auto million_rows = static_cast<double>(value_segment->size()) / 1e6;
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << million_rows / legacy_seconds << std::setw(14) << million_rows / seconds
+            << std::setw(10) << legacy_seconds / seconds << "x" << std::endl;
+}
+
+}  // namespace
+
+}  // namespace opossum
+
+int main(int argc, char* argv[]) {
+  using namespace opossum;  // NOLINT
+
+  const auto row_count = argc > 1 ? std::stoul(argv[1]) : size_t{1000000};
+  PerformanceWarningDisabler performance_warning_disabler;
+
+  std::cout << "Encoding " << row_count << " rows, in million rows per second" << std::endl;
+  std::cout << std::left << std::setw(24) << "column" << std::right << std::setw(14) << "before" << std::setw(14)
+            << "after" << std::setw(11) << "speedup" << std::endl;
+
+  for (const auto distinct_count : {size_t{10}, size_t{1000}, size_t{100000}, row_count}) {
+    auto int_segment = std::make_shared<ValueSegment<int32_t>>();
+    auto string_segment = std::make_shared<ValueSegment<std::string>>();
+    for (size_t row = 0; row < row_count; ++row) {
+      // A multiplicative hash scatters the values, so that the input is not sorted
+      const auto value = static_cast<int32_t>((row * 2654435761u) % distinct_count);
+      int_segment->append(value);
+      string_segment->append("customer#" + std::to_string(value));
+    }
+
+    benchmark("int, " + std::to_string(distinct_count) + " distinct", int_segment);
+    benchmark("string, " + std::to_string(distinct_count) + " distinct", string_segment);
+  }
+
+  return 0;
+}
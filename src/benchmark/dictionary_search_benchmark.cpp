@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "storage/eytzinger_index.hpp"
+
+/**
+ * Measures how long a search in a sorted dictionary takes with std::lower_bound, which DictionarySegment uses for
+ * small dictionaries, and with the EytzingerIndex it uses for large ones, for dictionaries of increasing size.
+ *
+ * Usage: hyriseDictionarySearchBenchmark [search_count]
+ */
+
+namespace opossum {
+
+namespace {
+
+// Returns the best of three runs in seconds
+template <typename Functor>
+double measure(const Functor& functor) {
+  auto best = std::numeric_limits<double>::max();
+  for (auto run = 0; run < 3; ++run) {
+    const auto begin = std::chrono::steady_clock::now();
+    functor();
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - begin).count());
+  }
+  return best;
+}
+
+template <typename T>
+void benchmark(const std::string& name, const size_t dictionary_size, const size_t search_count) {
+  // Even values, so that half of the searched values are not in the dictionary
+  auto dictionary = std::vector<T>(dictionary_size);
+  for (size_t index = 0; index < dictionary_size; ++index) dictionary[index] = static_cast<T>(index * 2);
+  const auto index = EytzingerIndex<T>{dictionary};
+
+  // A multiplicative hash scatters the searched values over the dictionary
+  auto search_values = std::vector<T>(search_count);
+  for (size_t search = 0; search < search_count; ++search) {
+    search_values[search] = static_cast<T>((search * 2654435761u) % (dictionary_size * 2));
+  }
+
+  // The sum of the results keeps the compiler from removing the searches
+  auto checksum = size_t{0};
+  auto eytzinger_checksum = size_t{0};
+  const auto binary_search_seconds = measure([&]() {
+    for (const auto value : search_values) {
+      checksum += std::lower_bound(dictionary.cbegin(), dictionary.cend(), value) - dictionary.cbegin();
+    }
+  });
+  const auto eytzinger_seconds = measure([&]() {
+    for (const auto value : search_values) eytzinger_checksum += index.lower_bound(value);
+  });
+  if (checksum != eytzinger_checksum) std::cout << "Results differ" << std::endl;
+
+  const auto nanoseconds_per_search = 1e9 / static_cast<double>(search_count);
+  std::cout << std::left << std::setw(10) << name << std::right << std::setw(12) << dictionary_size << std::fixed
+            << std::setprecision(1) << std::setw(16) << binary_search_seconds * nanoseconds_per_search
+            << std::setw(12) << eytzinger_seconds * nanoseconds_per_search << std::setw(10)
+            << binary_search_seconds / eytzinger_seconds << "x" << std::endl;
+}
+
+}  // namespace
+
+}  // namespace opossum
+
+int main(int argc, char* argv[]) {
+  using namespace opossum;  // NOLINT
+
+  const auto search_count = argc > 1 ? std::stoul(argv[1]) : size_t{1000000};
+
+  std::cout << search_count << " searches per dictionary, in nanoseconds per search" << std::endl;
+  std::cout << std::left << std::setw(10) << "type" << std::right << std::setw(12) << "size" << std::setw(16)
+            << "lower_bound" << std::setw(12) << "Eytzinger" << std::setw(11) << "speedup" << std::endl;
+
+  for (auto dictionary_size = size_t{1} << 10; dictionary_size <= size_t{1} << 26; dictionary_size <<= 2) {
+    benchmark<int32_t>("int", dictionary_size, search_count);
+    benchmark<double>("double", dictionary_size, search_count);
+  }
+
+  return 0;
+}
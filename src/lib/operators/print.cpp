@@ -4,17 +4,38 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "operators/table_wrapper.hpp"
+#include "resolve_type.hpp"
 #include "storage/base_segment.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
-#include "type_cast.hpp"
-#include "utils/performance_warning.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Returns the printed representation of each value of the segment
+std::vector<std::string> format_values(const std::string& column_type, const BaseSegment& segment) {
+  auto cells = std::vector<std::string>{};
+  cells.reserve(segment.size());
+  resolve_data_type(column_type, [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    auto stream = std::ostringstream{};
+    segment_iterate<ColumnDataType>(segment, [&](const auto& value) {
+      stream.str("");
+      stream << value;
+      cells.emplace_back(stream.str());
+    });
+  });
+  return cells;
+}
+
+}  // namespace
+
 Print::Print(const std::shared_ptr<const AbstractOperator> in, std::ostream& out) : AbstractOperator(in), _out(out) {}
 
 void Print::print(std::shared_ptr<const Table> table, std::ostream& out) {
@@ -24,8 +45,6 @@ void Print::print(std::shared_ptr<const Table> table, std::ostream& out) {
 }
 
 std::shared_ptr<const Table> Print::_on_execute() {
-  PerformanceWarningDisabler pwd;
-
   auto widths = column_string_widths(8, 20, _input_table_left());
 
   // print column headers
@@ -50,13 +69,17 @@ std::shared_ptr<const Table> Print::_on_execute() {
       continue;
     }
 
+    // the values are read column by column and printed row by row
+    auto cells = std::vector<std::vector<std::string>>{};
+    for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+      cells.emplace_back(format_values(_input_table_left()->column_type(column_id), *chunk.get_segment(column_id)));
+    }
+
     // print the rows in the chunk
     for (size_t row = 0; row < chunk.size(); ++row) {
       _out << "|";
       for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
-        // well yes, we use BaseSegment::operator[] here, but since Print is not an operation that should
-        // be part of a regular query plan, let's keep things simple here
-        _out << std::setw(widths[column_id]) << (*chunk.get_segment(column_id))[row] << "|" << std::setw(0);
+        _out << std::setw(widths[column_id]) << cells[column_id][row] << "|" << std::setw(0);
       }
 
       _out << std::endl;
@@ -81,9 +104,8 @@ std::vector<uint16_t> Print::column_string_widths(uint16_t min, uint16_t max, st
     auto& chunk = _input_table_left()->get_chunk(chunk_id);
 
     for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
-      for (size_t row = 0; row < chunk.size(); ++row) {
-        auto cell_length =
-            static_cast<uint16_t>(boost::lexical_cast<std::string>((*chunk.get_segment(column_id))[row]).size());
+      for (const auto& cell : format_values(t->column_type(column_id), *chunk.get_segment(column_id))) {
+        auto cell_length = static_cast<uint16_t>(cell.size());
         widths[column_id] = std::max({min, widths[column_id], std::min(max, cell_length)});
       }
     }
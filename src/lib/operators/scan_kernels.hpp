@@ -0,0 +1,491 @@
+#pragma once
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "types.hpp"
+
+/**
+ * Predicate kernels for scans on contiguous, uncompressed values.
+ *
+ * All kernels take the scan type as a template parameter, so that every combination of data type and predicate gets
+ * its own, fully inlined loop. Use resolve_scan_type() to get from a runtime ScanType to the kernel.
+ *
+ * For int32, int64, float, and double, blocks of values are compared against the search value with a single SIMD
+ * instruction. The resulting bit mask is turned into chunk offsets without branching on individual values. AVX2 is
+ * used if the compiler targets it (e.g., via -march=native in release builds), SSE4.2 otherwise. Other types, and
+ * builds without either instruction set, use a scalar loop.
+ *
+ * scan_value_ids() does the same for the unsigned codes of an attribute vector, e.g., 32 uint8_t codes per AVX2
+ * instruction.
+ */
+
+namespace opossum {
+
+namespace detail {
+
+// Used to reject unhandled scan types in `if constexpr` chains at compile time
+template <ScanType scan_type>
+constexpr bool unsupported_scan_type = false;
+
+}  // namespace detail
+
+// Evaluates `value <scan_type> search_value`
+template <ScanType scan_type, typename T>
+inline bool scan_compare(const T& value, const T& search_value) {
+  if constexpr (scan_type == ScanType::OpEquals) {
+    return value == search_value;
+  } else if constexpr (scan_type == ScanType::OpNotEquals) {
+    return value != search_value;
+  } else if constexpr (scan_type == ScanType::OpLessThan) {
+    return value < search_value;
+  } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+    return value <= search_value;
+  } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+    return value > search_value;
+  } else if constexpr (scan_type == ScanType::OpGreaterThanEquals) {
+    return value >= search_value;
+  } else {
+    static_assert(detail::unsupported_scan_type<scan_type>, "Unsupported scan type");
+  }
+}
+
+namespace detail {
+
+// For scan types that are the negation of another one, returns the scan type that is actually compared with SIMD
+// instructions. The resulting mask is inverted afterwards.
+template <ScanType scan_type>
+constexpr ScanType non_negated_scan_type() {
+  if constexpr (scan_type == ScanType::OpNotEquals) {
+    return ScanType::OpEquals;
+  } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+    return ScanType::OpGreaterThan;
+  } else if constexpr (scan_type == ScanType::OpGreaterThanEquals) {
+    return ScanType::OpLessThan;
+  } else {
+    return scan_type;
+  }
+}
+
+template <ScanType scan_type>
+constexpr bool is_negated_scan_type() {
+  return non_negated_scan_type<scan_type>() != scan_type;
+}
+
+// Provides lane_count, broadcast(), and compare() for types that can be compared with SIMD instructions.
+// compare() returns a bit mask with one bit per lane that is set if the value in this lane matches.
+template <typename T>
+struct SimdComparator {
+  static constexpr bool is_supported = false;
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct SimdComparator<int32_t> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 8;
+  using Register = __m256i;
+
+  static Register broadcast(const int32_t value) { return _mm256_set1_epi32(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const int32_t* values, const Register search_values) {
+    const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    constexpr auto compared_scan_type = non_negated_scan_type<scan_type>();
+    Register result;
+    if constexpr (compared_scan_type == ScanType::OpEquals) {
+      result = _mm256_cmpeq_epi32(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpGreaterThan) {
+      result = _mm256_cmpgt_epi32(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpLessThan) {
+      result = _mm256_cmpgt_epi32(search_values, block);
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+    return is_negated_scan_type<scan_type>() ? ~mask & 0xFF : mask;
+  }
+};
+
+template <>
+struct SimdComparator<int64_t> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 4;
+  using Register = __m256i;
+
+  static Register broadcast(const int64_t value) { return _mm256_set1_epi64x(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const int64_t* values, const Register search_values) {
+    const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    constexpr auto compared_scan_type = non_negated_scan_type<scan_type>();
+    Register result;
+    if constexpr (compared_scan_type == ScanType::OpEquals) {
+      result = _mm256_cmpeq_epi64(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpGreaterThan) {
+      result = _mm256_cmpgt_epi64(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpLessThan) {
+      result = _mm256_cmpgt_epi64(search_values, block);
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+    return is_negated_scan_type<scan_type>() ? ~mask & 0xF : mask;
+  }
+};
+
+// Floating point comparisons cannot be derived from their negation because of NaN. Instead, we use the ordered
+// predicates (false for NaN) and the unordered one for OpNotEquals (true for NaN), which matches the scalar operators.
+template <ScanType scan_type>
+constexpr int avx_float_predicate() {
+  if constexpr (scan_type == ScanType::OpEquals) {
+    return _CMP_EQ_OQ;
+  } else if constexpr (scan_type == ScanType::OpNotEquals) {
+    return _CMP_NEQ_UQ;
+  } else if constexpr (scan_type == ScanType::OpLessThan) {
+    return _CMP_LT_OQ;
+  } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+    return _CMP_LE_OQ;
+  } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+    return _CMP_GT_OQ;
+  } else if constexpr (scan_type == ScanType::OpGreaterThanEquals) {
+    return _CMP_GE_OQ;
+  } else {
+    static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+  }
+}
+
+template <>
+struct SimdComparator<float> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 8;
+  using Register = __m256;
+
+  static Register broadcast(const float value) { return _mm256_set1_ps(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const float* values, const Register search_values) {
+    const auto block = _mm256_loadu_ps(values);
+    constexpr auto predicate = avx_float_predicate<scan_type>();
+    return _mm256_movemask_ps(_mm256_cmp_ps(block, search_values, predicate));
+  }
+};
+
+template <>
+struct SimdComparator<double> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 4;
+  using Register = __m256d;
+
+  static Register broadcast(const double value) { return _mm256_set1_pd(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const double* values, const Register search_values) {
+    const auto block = _mm256_loadu_pd(values);
+    constexpr auto predicate = avx_float_predicate<scan_type>();
+    return _mm256_movemask_pd(_mm256_cmp_pd(block, search_values, predicate));
+  }
+};
+
+#elif defined(__SSE4_2__)
+
+template <>
+struct SimdComparator<int32_t> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 4;
+  using Register = __m128i;
+
+  static Register broadcast(const int32_t value) { return _mm_set1_epi32(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const int32_t* values, const Register search_values) {
+    const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+    constexpr auto compared_scan_type = non_negated_scan_type<scan_type>();
+    Register result;
+    if constexpr (compared_scan_type == ScanType::OpEquals) {
+      result = _mm_cmpeq_epi32(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpGreaterThan) {
+      result = _mm_cmpgt_epi32(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpLessThan) {
+      result = _mm_cmpgt_epi32(search_values, block);
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+    const auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(result)));
+    return is_negated_scan_type<scan_type>() ? ~mask & 0xF : mask;
+  }
+};
+
+template <>
+struct SimdComparator<int64_t> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 2;
+  using Register = __m128i;
+
+  static Register broadcast(const int64_t value) { return _mm_set1_epi64x(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const int64_t* values, const Register search_values) {
+    const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+    constexpr auto compared_scan_type = non_negated_scan_type<scan_type>();
+    Register result;
+    if constexpr (compared_scan_type == ScanType::OpEquals) {
+      result = _mm_cmpeq_epi64(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpGreaterThan) {
+      result = _mm_cmpgt_epi64(block, search_values);
+    } else if constexpr (compared_scan_type == ScanType::OpLessThan) {
+      result = _mm_cmpgt_epi64(search_values, block);
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+    const auto mask = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(result)));
+    return is_negated_scan_type<scan_type>() ? ~mask & 0x3 : mask;
+  }
+};
+
+// See the AVX2 version for why floating point comparisons are not derived from their negation
+template <>
+struct SimdComparator<float> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 4;
+  using Register = __m128;
+
+  static Register broadcast(const float value) { return _mm_set1_ps(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const float* values, const Register search_values) {
+    const auto block = _mm_loadu_ps(values);
+    if constexpr (scan_type == ScanType::OpEquals) {
+      return _mm_movemask_ps(_mm_cmpeq_ps(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpNotEquals) {
+      return _mm_movemask_ps(_mm_cmpneq_ps(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpLessThan) {
+      return _mm_movemask_ps(_mm_cmplt_ps(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+      return _mm_movemask_ps(_mm_cmple_ps(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+      return _mm_movemask_ps(_mm_cmpgt_ps(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpGreaterThanEquals) {
+      return _mm_movemask_ps(_mm_cmpge_ps(block, search_values));
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+  }
+};
+
+template <>
+struct SimdComparator<double> {
+  static constexpr bool is_supported = true;
+  static constexpr uint32_t lane_count = 2;
+  using Register = __m128d;
+
+  static Register broadcast(const double value) { return _mm_set1_pd(value); }
+
+  template <ScanType scan_type>
+  static uint32_t compare(const double* values, const Register search_values) {
+    const auto block = _mm_loadu_pd(values);
+    if constexpr (scan_type == ScanType::OpEquals) {
+      return _mm_movemask_pd(_mm_cmpeq_pd(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpNotEquals) {
+      return _mm_movemask_pd(_mm_cmpneq_pd(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpLessThan) {
+      return _mm_movemask_pd(_mm_cmplt_pd(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+      return _mm_movemask_pd(_mm_cmple_pd(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+      return _mm_movemask_pd(_mm_cmpgt_pd(block, search_values));
+    } else if constexpr (scan_type == ScanType::OpGreaterThanEquals) {
+      return _mm_movemask_pd(_mm_cmpge_pd(block, search_values));
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+  }
+};
+
+#endif
+
+// Compares blocks of unsigned codes of up to 32 bit. SIMD instructions only offer signed "greater than" comparisons,
+// which is why `code >= search_code` is computed as `max(code, search_code) == code` and `code <= search_code` as
+// `min(code, search_code) == code`. All other scan types are the negation of one of these or of `==`.
+template <typename Code, typename Enable = void>
+struct SimdCodeComparator {
+  static constexpr bool is_supported = false;
+};
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+
+template <typename Code>
+struct SimdCodeComparator<Code, std::enable_if_t<std::is_unsigned<Code>::value && sizeof(Code) <= 4>> {
+  static constexpr bool is_supported = true;
+
+#if defined(__AVX2__)
+  using Register = __m256i;
+  static constexpr uint32_t register_size = 32;
+#else
+  using Register = __m128i;
+  static constexpr uint32_t register_size = 16;
+#endif
+
+  static constexpr uint32_t lane_count = register_size / sizeof(Code);
+
+  // The byte-wise movemask yields sizeof(Code) bits per lane, of which we only keep the lowest one
+  static constexpr uint32_t lane_mask = (sizeof(Code) == 1 ? 0xFFFFFFFF : sizeof(Code) == 2 ? 0x55555555 : 0x11111111) &
+                                        (register_size == 32 ? 0xFFFFFFFF : 0xFFFF);
+
+#if defined(__AVX2__)
+  static Register broadcast(const Code code) {
+    if constexpr (sizeof(Code) == 1) return _mm256_set1_epi8(static_cast<char>(code));
+    if constexpr (sizeof(Code) == 2) return _mm256_set1_epi16(static_cast<int16_t>(code));
+    return _mm256_set1_epi32(static_cast<int32_t>(code));
+  }
+
+  static Register load(const Code* codes) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes)); }
+
+  static Register maximum(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return _mm256_max_epu8(lhs, rhs);
+    if constexpr (sizeof(Code) == 2) return _mm256_max_epu16(lhs, rhs);
+    return _mm256_max_epu32(lhs, rhs);
+  }
+
+  static Register minimum(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return _mm256_min_epu8(lhs, rhs);
+    if constexpr (sizeof(Code) == 2) return _mm256_min_epu16(lhs, rhs);
+    return _mm256_min_epu32(lhs, rhs);
+  }
+
+  static uint32_t equal_mask(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+    if constexpr (sizeof(Code) == 2) return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(lhs, rhs)));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(lhs, rhs)));
+  }
+#else
+  static Register broadcast(const Code code) {
+    if constexpr (sizeof(Code) == 1) return _mm_set1_epi8(static_cast<char>(code));
+    if constexpr (sizeof(Code) == 2) return _mm_set1_epi16(static_cast<int16_t>(code));
+    return _mm_set1_epi32(static_cast<int32_t>(code));
+  }
+
+  static Register load(const Code* codes) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes)); }
+
+  static Register maximum(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return _mm_max_epu8(lhs, rhs);
+    if constexpr (sizeof(Code) == 2) return _mm_max_epu16(lhs, rhs);
+    return _mm_max_epu32(lhs, rhs);
+  }
+
+  static Register minimum(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return _mm_min_epu8(lhs, rhs);
+    if constexpr (sizeof(Code) == 2) return _mm_min_epu16(lhs, rhs);
+    return _mm_min_epu32(lhs, rhs);
+  }
+
+  static uint32_t equal_mask(const Register lhs, const Register rhs) {
+    if constexpr (sizeof(Code) == 1) return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+    if constexpr (sizeof(Code) == 2) return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(lhs, rhs)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(lhs, rhs)));
+  }
+#endif
+
+  template <ScanType scan_type>
+  static uint32_t compare(const Code* codes, const Register search_codes) {
+    const auto block = load(codes);
+
+    uint32_t mask;
+    if constexpr (scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals) {
+      mask = equal_mask(block, search_codes);
+    } else if constexpr (scan_type == ScanType::OpGreaterThanEquals || scan_type == ScanType::OpLessThan) {
+      mask = equal_mask(maximum(block, search_codes), block);
+    } else if constexpr (scan_type == ScanType::OpLessThanEquals || scan_type == ScanType::OpGreaterThan) {
+      mask = equal_mask(minimum(block, search_codes), block);
+    } else {
+      static_assert(unsupported_scan_type<scan_type>, "Unsupported scan type");
+    }
+
+    if constexpr (scan_type == ScanType::OpNotEquals || scan_type == ScanType::OpLessThan ||
+                  scan_type == ScanType::OpGreaterThan) {
+      mask = ~mask;
+    }
+    return mask & lane_mask;
+  }
+};
+
+#endif
+
+// Adds a match to a PosList, or only its offset to the offsets of a single chunk
+inline void append_position(PosList& pos_list, const ChunkID chunk_id, const ChunkOffset chunk_offset) {
+  pos_list.emplace_back(RowID{chunk_id, chunk_offset});
+}
+
+inline void append_position(std::vector<ChunkOffset>& chunk_offsets, const ChunkID, const ChunkOffset chunk_offset) {
+  chunk_offsets.emplace_back(chunk_offset);
+}
+
+}  // namespace detail
+
+// Appends a RowID for every value in values[0..value_count) that satisfies `value <scan_type> search_value` to
+// pos_list. values[0] is expected to be located at first_chunk_offset within the chunk chunk_id. pos_list may also be
+// a std::vector<ChunkOffset>, which receives the chunk offsets only (see SingleChunkPosList).
+template <ScanType scan_type, typename T, typename Positions>
+void scan_values(const T* values, const size_t value_count, const T& search_value, const ChunkID chunk_id,
+                 const ChunkOffset first_chunk_offset, Positions& pos_list) {
+  size_t index = 0;
+
+  if constexpr (detail::SimdComparator<T>::is_supported) {
+    using Comparator = detail::SimdComparator<T>;
+    const auto search_values = Comparator::broadcast(search_value);
+
+    for (; index + Comparator::lane_count <= value_count; index += Comparator::lane_count) {
+      auto mask = Comparator::template compare<scan_type>(values + index, search_values);
+      while (mask != 0) {
+        const auto lane = static_cast<ChunkOffset>(__builtin_ctz(mask));
+        detail::append_position(pos_list, chunk_id, static_cast<ChunkOffset>(first_chunk_offset + index + lane));
+        mask &= mask - 1;
+      }
+    }
+  }
+
+  for (; index < value_count; ++index) {
+    if (scan_compare<scan_type>(values[index], search_value)) {
+      detail::append_position(pos_list, chunk_id, static_cast<ChunkOffset>(first_chunk_offset + index));
+    }
+  }
+}
+
+// Appends a RowID for every code in codes[0..code_count) that satisfies `code <scan_type> search_code` to pos_list.
+// codes[0] is expected to be located at first_chunk_offset within the chunk chunk_id. pos_list may also be a
+// std::vector<ChunkOffset>, as for scan_values().
+template <ScanType scan_type, typename Code, typename Positions>
+void scan_value_ids(const Code* codes, const size_t code_count, const Code search_code, const ChunkID chunk_id,
+                    const ChunkOffset first_chunk_offset, Positions& pos_list) {
+  size_t index = 0;
+
+  if constexpr (detail::SimdCodeComparator<Code>::is_supported) {
+    using Comparator = detail::SimdCodeComparator<Code>;
+    const auto search_codes = Comparator::broadcast(search_code);
+
+    for (; index + Comparator::lane_count <= code_count; index += Comparator::lane_count) {
+      auto mask = Comparator::template compare<scan_type>(codes + index, search_codes);
+      while (mask != 0) {
+        const auto lane = static_cast<ChunkOffset>(__builtin_ctz(mask) / sizeof(Code));
+        detail::append_position(pos_list, chunk_id, static_cast<ChunkOffset>(first_chunk_offset + index + lane));
+        mask &= mask - 1;
+      }
+    }
+  }
+
+  for (; index < code_count; ++index) {
+    if (scan_compare<scan_type>(codes[index], search_code)) {
+      detail::append_position(pos_list, chunk_id, static_cast<ChunkOffset>(first_chunk_offset + index));
+    }
+  }
+}
+
+}  // namespace opossum
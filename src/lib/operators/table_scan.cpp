@@ -11,19 +11,24 @@
 namespace opossum {
 
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id, const ScanType scan_type,
-                     const AllTypeVariant search_value)
-    : AbstractOperator(in), _column_id(column_id), _scan_type(scan_type), _search_value(search_value) {}
+                     const AllTypeVariant search_value, const size_t max_parallelism)
+    : AbstractOperator(in),
+      _column_id(column_id),
+      _scan_type(scan_type),
+      _search_value(search_value),
+      _max_parallelism(max_parallelism) {}
 
 ColumnID TableScan::column_id() const { return _column_id; }
 ScanType TableScan::scan_type() const { return _scan_type; }
 const AllTypeVariant& TableScan::search_value() const { return _search_value; }
+size_t TableScan::max_parallelism() const { return _max_parallelism; }
 
 // Create a TableScanImpl using the column type of the input table.
 
 std::shared_ptr<const Table> TableScan::_on_execute() {
   const auto& column_type = _input_table_left()->column_type(_column_id);
   _table_scan_impl = make_unique_by_data_type<TableScan::BaseTableScanImpl, TableScan::TableScanImpl>(
-      column_type, _input_table_left(), _column_id, _scan_type, _search_value);
+      column_type, _input_table_left(), _column_id, _scan_type, _search_value, _max_parallelism);
 
   const auto& return_table = _table_scan_impl->on_execute();
 
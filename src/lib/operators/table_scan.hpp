@@ -1,14 +1,33 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "abstract_operator.hpp"
 #include "all_type_variant.hpp"
+#include "resolve_type.hpp"
+#include "scan_kernels.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/bit_packed_attribute_vector.hpp"
+#include "storage/contiguous_string_segment.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/fitted_attribute_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/front_coded_dictionary_segment.hpp"
+#include "storage/gorilla_segment.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/segment_statistics.hpp"
 #include "storage/table.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -20,14 +39,16 @@ class Table;
 
 class TableScan : public AbstractOperator {
  public:
+  // max_parallelism limits the number of threads that scan the input chunks. 0 uses all workers of the WorkerPool.
   TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id, const ScanType scan_type,
-            const AllTypeVariant search_value);
+            const AllTypeVariant search_value, const size_t max_parallelism = 0);
 
   ~TableScan() = default;
 
   ColumnID column_id() const;
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
+  size_t max_parallelism() const;
 
  protected:
   class BaseTableScanImpl {
@@ -44,8 +65,12 @@ class TableScan : public AbstractOperator {
   class TableScanImpl : public BaseTableScanImpl {
    public:
     TableScanImpl(const std::shared_ptr<const Table> table, ColumnID column_id, const ScanType scan_type,
-                  const AllTypeVariant search_value)
-        : _table(table), _column_id(column_id), _scan_type(scan_type), _search_value(search_value){}
+                  const AllTypeVariant search_value, const size_t max_parallelism)
+        : _table(table),
+          _column_id(column_id),
+          _scan_type(scan_type),
+          _search_value(search_value),
+          _max_parallelism(max_parallelism) {}
     ~TableScanImpl() = default;
 
    protected:
@@ -53,134 +78,427 @@ class TableScan : public AbstractOperator {
     const ColumnID _column_id;
     const ScanType _scan_type;
     const AllTypeVariant _search_value;
+    const size_t _max_parallelism;
+
+    // Creates the output chunk for the matches of an input chunk, which are rows of that chunk. The output segments
+    // reference the base table: if the input segments are reference segments themselves, the matches are mapped to the
+    // rows that those reference, so that chained scans do not create chains of references. The positions stay in a
+    // single chunk unless the input segments reference rows of several chunks.
+    Chunk create_result_chunk(const ChunkID chunk_id, const std::shared_ptr<const SingleChunkPosList>& matches) const {
+      const auto& input_chunk = _table->get_chunk(chunk_id);
+      const auto& match_offsets = matches->chunk_offsets;
+      auto result_chunk = Chunk{};
+
+      // The columns of an input chunk usually share their position list, so their output segments share one as well
+      auto mapped_single_chunk_pos_lists = std::unordered_map<std::shared_ptr<const SingleChunkPosList>,
+                                                              std::shared_ptr<const SingleChunkPosList>>{};
+      auto mapped_pos_lists = std::unordered_map<std::shared_ptr<const PosList>, std::shared_ptr<const PosList>>{};
+      for (ColumnID column_id{0}; column_id < _table->column_count(); ++column_id) {
+        const auto reference_segment =
+            std::dynamic_pointer_cast<const ReferenceSegment>(input_chunk.get_segment(column_id));
+        if (!reference_segment) {
+          result_chunk.add_segment(std::make_shared<ReferenceSegment>(_table, column_id, matches));
+          continue;
+        }
+
+        const auto& referenced_table = reference_segment->referenced_table();
+        const auto referenced_column_id = reference_segment->referenced_column_id();
+        if (const auto& input_pos_list = reference_segment->single_chunk_pos_list()) {
+          auto& mapped_pos_list = mapped_single_chunk_pos_lists[input_pos_list];
+          if (!mapped_pos_list) {
+            auto pos_list = std::make_shared<SingleChunkPosList>(SingleChunkPosList{input_pos_list->chunk_id, {}});
+            pos_list->chunk_offsets.reserve(match_offsets.size());
+            for (const auto offset : match_offsets) {
+              pos_list->chunk_offsets.emplace_back(input_pos_list->chunk_offsets[offset]);
+            }
+            mapped_pos_list = std::move(pos_list);
+          }
+          result_chunk.add_segment(
+              std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, mapped_pos_list));
+        } else {
+          auto& mapped_pos_list = mapped_pos_lists[reference_segment->pos_list()];
+          if (!mapped_pos_list) {
+            const auto& input_pos_list = *reference_segment->pos_list();
+            auto pos_list = std::make_shared<PosList>();
+            pos_list->reserve(match_offsets.size());
+            for (const auto offset : match_offsets) pos_list->emplace_back(input_pos_list[offset]);
+            mapped_pos_list = std::move(pos_list);
+          }
+          result_chunk.add_segment(
+              std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, mapped_pos_list));
+        }
+      }
+      return result_chunk;
+    }
+
+    // A predicate on the value ids of a dictionary segment. Unless all or no rows match, a row matches if
+    // `value_id <scan_type> search_value_id` holds.
+    struct ValueIDPredicate {
+      bool matches_all;
+      bool matches_none;
+      ScanType scan_type;
+      ValueID search_value_id;
+    };
+
+    // As the dictionary is sorted, every predicate on values can be expressed as OpEquals, OpNotEquals, OpLessThan, or
+    // OpGreaterThanEquals on value ids - or it matches all or no rows of the segment. Segment is a DictionarySegment<T>
+    // or a FrontCodedDictionarySegment.
+    template <typename Segment>
+    ValueIDPredicate translate_to_value_ids(const Segment& segment, const T& search_value) const {
+      const auto all = ValueIDPredicate{true, false, _scan_type, INVALID_VALUE_ID};
+      const auto none = ValueIDPredicate{false, true, _scan_type, INVALID_VALUE_ID};
 
-    template <typename U>
-    std::function<bool(const U&, const U&)> compare() {
       switch (_scan_type) {
         case ScanType::OpEquals:
-          return [](const U& lhs, const U& rhs) { return lhs == rhs; };
-          break;
-        case ScanType::OpGreaterThan:
-          return [](const U& lhs, const U& rhs) { return lhs > rhs; };
-          break;
-        case ScanType::OpGreaterThanEquals:
-          return [](const U& lhs, const U& rhs) { return lhs >= rhs; };
-          break;
+        case ScanType::OpNotEquals: {
+          const auto lower_bound = segment.lower_bound(search_value);
+          const auto is_contained =
+              lower_bound != INVALID_VALUE_ID && segment.value_by_value_id(lower_bound) == search_value;
+          if (!is_contained) return _scan_type == ScanType::OpEquals ? none : all;
+          return ValueIDPredicate{false, false, _scan_type, lower_bound};
+        }
         case ScanType::OpLessThan:
-          return [](const U& lhs, const U& rhs) { return lhs < rhs; };
-          break;
+        case ScanType::OpGreaterThanEquals: {
+          const auto lower_bound = segment.lower_bound(search_value);
+          if (lower_bound == INVALID_VALUE_ID) return _scan_type == ScanType::OpLessThan ? all : none;
+          if (lower_bound == ValueID{0}) return _scan_type == ScanType::OpLessThan ? none : all;
+          return ValueIDPredicate{false, false, _scan_type, lower_bound};
+        }
         case ScanType::OpLessThanEquals:
-          return [](const U& lhs, const U& rhs) { return lhs <= rhs; };
-          break;
-        case ScanType::OpNotEquals:
-          return [](const U& lhs, const U& rhs) { return lhs != rhs; };
-          break;
-        default:
-          return [](const U& lhs, const U& rhs) { return false; };
-          break;
+        case ScanType::OpGreaterThan: {
+          // `value <= search_value` is the same as `value_id < upper_bound`, `>` is the same as `>= upper_bound`
+          const auto upper_bound = segment.upper_bound(search_value);
+          const auto scan_type =
+              _scan_type == ScanType::OpLessThanEquals ? ScanType::OpLessThan : ScanType::OpGreaterThanEquals;
+          if (upper_bound == INVALID_VALUE_ID) return scan_type == ScanType::OpLessThan ? all : none;
+          if (upper_bound == ValueID{0}) return scan_type == ScanType::OpLessThan ? none : all;
+          return ValueIDPredicate{false, false, scan_type, upper_bound};
+        }
       }
+      Fail("Unknown scan type");
+      return none;
     }
 
-    // Iterate over all columns of the input table and create reference segments using the pos list.
-    // If the column is a reference segment, use the referenced table to create the new reference segment.
-    // Add the segments and their definitions to a single chunk of a new table.
-    std::shared_ptr<Table> create_result_table(uint64_t result_size, const std::shared_ptr<PosList> pos_list) {
-      const auto& result_table = std::make_shared<Table>(result_size);
+    // Scans the codes of the attribute vector if it is a FittedAttributeVector<Code>. Returns false otherwise.
+    template <typename Code>
+    bool scan_attribute_vector(const std::shared_ptr<const BaseAttributeVector>& attribute_vector,
+                               const ValueIDPredicate& predicate, const ChunkID chunk_id,
+                               std::vector<ChunkOffset>& matches) const {
+      const auto fitted_attribute_vector =
+          std::dynamic_pointer_cast<const FittedAttributeVector<Code>>(attribute_vector);
+      if (!fitted_attribute_vector) return false;
 
-      for (ColumnID segment_index = ColumnID{0}; segment_index < _table->column_count(); ++segment_index) {
-        std::shared_ptr<ReferenceSegment> reference_segment;
+      // The search value id is smaller than the dictionary size and thus fits into Code
+      resolve_scan_type(predicate.scan_type, [&](auto type) {
+        scan_value_ids<decltype(type)::value>(fitted_attribute_vector->data(), fitted_attribute_vector->size(),
+                                              static_cast<Code>(predicate.search_value_id), chunk_id, ChunkOffset{0},
+                                              matches);
+      });
+      return true;
+    }
+
+    // Scans the value ids of the attribute vector if it is a BitPackedAttributeVector. Returns false otherwise.
+    // The value ids are unpacked block by block into a small buffer that stays in the L1 cache and is then scanned
+    // with the SIMD kernels.
+    bool scan_bit_packed_attribute_vector(const std::shared_ptr<const BaseAttributeVector>& attribute_vector,
+                                          const ValueIDPredicate& predicate, const ChunkID chunk_id,
+                                          std::vector<ChunkOffset>& matches) const {
+      const auto bit_packed_attribute_vector =
+          std::dynamic_pointer_cast<const BitPackedAttributeVector>(attribute_vector);
+      if (!bit_packed_attribute_vector) return false;
+
+      constexpr size_t block_size = 1024;
+      std::array<ValueID::base_type, block_size> value_ids;
 
-        if (const auto& column =
-                std::dynamic_pointer_cast<ReferenceSegment>(_table->get_chunk(ChunkID{0}).get_segment(segment_index))) {
-          reference_segment = std::make_shared<ReferenceSegment>(column->referenced_table(), segment_index, pos_list);
+      resolve_scan_type(predicate.scan_type, [&](auto type) {
+        const auto size = bit_packed_attribute_vector->size();
+        for (size_t first_offset = 0; first_offset < size; first_offset += block_size) {
+          const auto count = std::min(block_size, size - first_offset);
+          const auto chunk_offset = static_cast<ChunkOffset>(first_offset);
+          bit_packed_attribute_vector->decode(chunk_offset, count, value_ids.data());
+          scan_value_ids<decltype(type)::value>(value_ids.data(), count,
+                                                static_cast<ValueID::base_type>(predicate.search_value_id), chunk_id,
+                                                chunk_offset, matches);
+        }
+      });
+      return true;
+    }
+
+    // Scans the segment if it is a FrameOfReferenceSegment<T>. Returns false otherwise.
+    template <ScanType scan_type>
+    bool scan_frame_of_reference_segment(const std::shared_ptr<BaseSegment>& segment, const T& search_value,
+                                         const ChunkID chunk_id, std::vector<ChunkOffset>& matches) const {
+      if constexpr (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+        const auto column = std::dynamic_pointer_cast<const FrameOfReferenceSegment<T>>(segment);
+        if (!column) return false;
+
+        if (column->is_delta()) {
+          // Offsets of the delta variant depend on the preceding value, so blocks are decoded before the comparison
+          std::array<T, FrameOfReferenceSegment<T>::block_size> values;
+          for (size_t block_index = 0; block_index < column->block_count(); ++block_index) {
+            const auto first_offset = static_cast<ChunkOffset>(block_index * values.size());
+            column->decode_block(block_index, values.data());
+            scan_values<scan_type>(values.data(), std::min(values.size(), column->size() - first_offset),
+                                   search_value, chunk_id, first_offset, matches);
+          }
+        } else if (column->offsets()->bit_width() <= 32) {
+          scan_frame_of_reference_offsets<scan_type, uint32_t>(*column, search_value, chunk_id, matches);
         } else {
-          reference_segment = std::make_shared<ReferenceSegment>(_table, segment_index, pos_list);
+          scan_frame_of_reference_offsets<scan_type, uint64_t>(*column, search_value, chunk_id, matches);
         }
-        result_table->get_chunk(ChunkID{0}).add_segment(reference_segment);
-        result_table->add_column_definition(_table->column_name(segment_index), _table->column_type(segment_index));
+        return true;
       }
-      return result_table;
+      return false;
     }
 
-    std::shared_ptr<const Table> on_execute() {
-      const auto& pos_list = std::make_shared<PosList>();
-      uint64_t result_size = 0;
+    // Scans the segment if it is a GorillaSegment<T>. Returns false otherwise.
+    template <ScanType scan_type>
+    bool scan_gorilla_segment(const std::shared_ptr<BaseSegment>& segment, const T& search_value,
+                              const ChunkID chunk_id, std::vector<ChunkOffset>& matches) const {
+      if constexpr (std::is_floating_point<T>::value) {
+        const auto column = std::dynamic_pointer_cast<const GorillaSegment<T>>(segment);
+        if (!column) return false;
 
-      DebugAssert(_search_value.type() == typeid(T), "Types cannot be compared");
+        // Decode one block at a time into a buffer that stays in the L1 cache
+        std::array<T, GorillaSegment<T>::block_size> values;
+        for (size_t block_index = 0; block_index < column->block_count(); ++block_index) {
+          const auto first_offset = static_cast<ChunkOffset>(block_index * values.size());
+          column->decode_block(block_index, values.data());
+          scan_values<scan_type>(values.data(), std::min(values.size(), column->size() - first_offset), search_value,
+                                 chunk_id, first_offset, matches);
+        }
+        return true;
+      }
+      return false;
+    }
 
-      // Iterate over all chunks of the input table.
-      for (ChunkID chunk_index = ChunkID{0}; chunk_index < _table->chunk_count(); ++chunk_index) {
-        const auto& segment = _table->get_chunk(chunk_index).get_segment(_column_id);
-
-        // Determine if the search column in the chunk is a dictionary segment.
-        if (const auto& column = std::dynamic_pointer_cast<DictionarySegment<T>>(segment)) {
-          const auto& attribute_vector = column->attribute_vector();
-          ValueID value_id = ValueID{0};
-          bool is_greater_than_whole_chunk = false;
-          bool is_unequal_whole_chunk = false;
-
-          // Create the compare function for the respective scan type.
-          const auto& compare_function = compare<ValueID>();
-
-          // Get the value id of a value not less than the search value in the dictionary.
-          value_id = column->lower_bound(type_cast<T>(_search_value));
-
-          // For ScanType::OpEquals, ScanType::OpLessThanEquals, ScanType::OpNotEquals and ScanType::OpGreaterThan
-          // it can happen that the values in the whole segment are larger than the search value and lower_bound returns
-          // the value id 0 even though the corresponding attribute vector entry points to another value in the dictionary.
-          // To determine that we do not need to check the segment, the upper_bound is checked. If it does not return a
-          // value greater than 0, the value is definitely smaller than the search value and for ScanType::OpEquals and
-          // ScanType::OpLessThanEquals we can check the next chunk. For ScanType::OpNotEquals and ScanType::OpGreaterThan
-          // we can add the whole chunk to the result.
-          if (value_id == ValueID{0} && ValueID{0} == column->upper_bound(type_cast<T>(_search_value))) {
-            if (_scan_type == ScanType::OpEquals || _scan_type == ScanType::OpLessThanEquals) {
-              continue;
-            }
-            if (_scan_type == ScanType::OpNotEquals) {
-              is_unequal_whole_chunk = true;
-            }
-            if (_scan_type == ScanType::OpGreaterThan) {
-              is_greater_than_whole_chunk = true;
-            }
-          }
+    // Scans a DictionarySegment<T> or a FrontCodedDictionarySegment on its value ids
+    template <typename Segment>
+    void scan_dictionary_segment(const Segment& column, const T& search_value, const ChunkID chunk_id,
+                                 std::vector<ChunkOffset>& matches) const {
+      const auto predicate = translate_to_value_ids(column, search_value);
+      const auto& attribute_vector = column.attribute_vector();
 
-          // Add entry to pos list using the compare function.
-          for (ChunkOffset chunk_offset = 0; chunk_offset < attribute_vector->size(); ++chunk_offset) {
-            if (is_greater_than_whole_chunk || is_unequal_whole_chunk ||
-                compare_function(attribute_vector->get(chunk_offset), value_id)) {
-              pos_list->emplace_back(RowID({ChunkID{chunk_index}, ChunkOffset{chunk_offset}}));
-            }
+      if (predicate.matches_none) return;
+
+      if (predicate.matches_all) {
+        append_offset_range(0, static_cast<ChunkOffset>(attribute_vector->size()), matches);
+        return;
+      }
+
+      // Compare the codes directly if the width of the attribute vector is known, without a virtual call per row.
+      if (scan_attribute_vector<uint8_t>(attribute_vector, predicate, chunk_id, matches) ||
+          scan_attribute_vector<uint16_t>(attribute_vector, predicate, chunk_id, matches) ||
+          scan_attribute_vector<uint32_t>(attribute_vector, predicate, chunk_id, matches) ||
+          scan_bit_packed_attribute_vector(attribute_vector, predicate, chunk_id, matches)) {
+        return;
+      }
+
+      // Other attribute vectors are decoded into full-width value ids first.
+      auto value_ids = std::vector<ValueID::base_type>(attribute_vector->size());
+      for (ChunkOffset chunk_offset = 0; chunk_offset < attribute_vector->size(); ++chunk_offset) {
+        value_ids[chunk_offset] = attribute_vector->get(chunk_offset);
+      }
+      resolve_scan_type(predicate.scan_type, [&](auto type) {
+        scan_value_ids<decltype(type)::value>(value_ids.data(), value_ids.size(),
+                                              static_cast<ValueID::base_type>(predicate.search_value_id), chunk_id,
+                                              ChunkOffset{0}, matches);
+      });
+    }
+
+    // Scans the segment if it is a FrontCodedDictionarySegment and T is std::string. Returns false otherwise.
+    bool scan_front_coded_dictionary_segment(const std::shared_ptr<BaseSegment>& segment, const T& search_value,
+                                             const ChunkID chunk_id, std::vector<ChunkOffset>& matches) const {
+      if constexpr (std::is_same<T, std::string>::value) {
+        const auto column = std::dynamic_pointer_cast<const FrontCodedDictionarySegment>(segment);
+        if (!column) return false;
+        scan_dictionary_segment(*column, search_value, chunk_id, matches);
+        return true;
+      }
+      return false;
+    }
+
+    // Scans the segment if it is a ContiguousStringSegment and T is std::string. Returns false otherwise.
+    template <ScanType scan_type>
+    bool scan_contiguous_string_segment(const std::shared_ptr<BaseSegment>& segment, const T& search_value,
+                                        const ChunkID chunk_id, std::vector<ChunkOffset>& matches) const {
+      if constexpr (std::is_same<T, std::string>::value) {
+        const auto column = std::dynamic_pointer_cast<const ContiguousStringSegment>(segment);
+        if (!column) return false;
+
+        // The strings are compared where they are stored, one after another
+        const auto strings = column->strings();
+        const auto search_string = std::string_view{search_value};
+        for (ChunkOffset chunk_offset = 0; chunk_offset < strings.size(); ++chunk_offset) {
+          if (scan_compare<scan_type>(strings[chunk_offset], search_string)) {
+            matches.emplace_back(chunk_offset);
           }
+        }
+        return true;
+      }
+      return false;
+    }
 
-          // Determine if the search column in the chunk is a value segment.
-        } else if (const auto& column = std::dynamic_pointer_cast<ValueSegment<T>>(segment)) {
-          // Create the compare function for the respective scan type.
-          const auto& compare_function = compare<T>();
-          const auto& values = column->values();
+    // Scans a FrameOfReferenceSegment in offset space: Per block, the search value is translated into an offset from
+    // the block's minimum. The bit-packed offsets are then unpacked into Offset codes and compared with it, without
+    // adding the minimum back to every value.
+    template <ScanType scan_type, typename Offset>
+    void scan_frame_of_reference_offsets(const FrameOfReferenceSegment<T>& column, const T& search_value,
+                                         const ChunkID chunk_id, std::vector<ChunkOffset>& matches) const {
+      using UnsignedT = typename FrameOfReferenceSegment<T>::UnsignedT;
+      const auto& offsets = *column.offsets();
+      const auto max_offset = offsets.bit_width() == 64 ? ~uint64_t{0} : (uint64_t{1} << offsets.bit_width()) - 1;
 
-          // Add entry to pos list using the compare function.
-          for (ChunkOffset chunk_offset = 0; chunk_offset < values.size(); ++chunk_offset) {
-            if (compare_function(values[chunk_offset], type_cast<T>(_search_value))) {
-              pos_list->emplace_back(RowID({ChunkID{chunk_index}, ChunkOffset{chunk_offset}}));
-            }
+      std::array<Offset, FrameOfReferenceSegment<T>::block_size> block_offsets;
+      for (size_t block_index = 0; block_index < column.block_count(); ++block_index) {
+        const auto first_offset = static_cast<ChunkOffset>(block_index * block_offsets.size());
+        const auto count = std::min(block_offsets.size(), column.size() - first_offset);
+        const auto minimum = column.minimum_of(block_index);
+
+        // If the search value is outside of [minimum, minimum + max_offset], either all or no rows of the block match
+        const auto search_offset = static_cast<UnsignedT>(search_value) - static_cast<UnsignedT>(minimum);
+        if (search_value < minimum || search_offset > max_offset) {
+          constexpr auto all_values_greater_match = scan_type == ScanType::OpNotEquals ||
+                                                    scan_type == ScanType::OpGreaterThan ||
+                                                    scan_type == ScanType::OpGreaterThanEquals;
+          constexpr auto all_values_less_match = scan_type == ScanType::OpNotEquals ||
+                                                 scan_type == ScanType::OpLessThan ||
+                                                 scan_type == ScanType::OpLessThanEquals;
+          if (search_value < minimum ? all_values_greater_match : all_values_less_match) {
+            append_offset_range(first_offset, static_cast<ChunkOffset>(first_offset + count), matches);
           }
+          continue;
+        }
+
+        offsets.decode(first_offset, count, block_offsets.data());
+        scan_value_ids<scan_type>(block_offsets.data(), count, static_cast<Offset>(search_offset), chunk_id,
+                                  first_offset, matches);
+      }
+    }
+
+    // Appends the offsets [begin, end) to matches
+    static void append_offset_range(const ChunkOffset begin, const ChunkOffset end, std::vector<ChunkOffset>& matches) {
+      for (auto chunk_offset = begin; chunk_offset < end; ++chunk_offset) {
+        matches.emplace_back(chunk_offset);
+      }
+    }
+
+    // Split the chunks of the input table into contiguous ranges and scan each range in its own task. Every input chunk
+    // with matches becomes an output chunk with its own position list, so that the following operators can process
+    // the chunks in parallel, too. The output chunks keep the order of the input chunks regardless of the scheduling.
+    // The scan type is resolved once, so that the comparison is inlined into the scan loops.
+    std::shared_ptr<const Table> on_execute() {
+      DebugAssert(_search_value.type() == typeid(T), "Types cannot be compared");
 
-          // Determine if the search column in the chunk is a reference segment.
-        } else if (const auto& column = std::dynamic_pointer_cast<ReferenceSegment>(segment)) {
-          // Create the compare function for the respective scan type.
-          const auto& compare_function = compare<T>();
-          const auto& row_count = _table->row_count();
-
-          // Add entry to pos list using the compare function.
-          for (ChunkOffset chunk_offset = 0; chunk_offset < row_count; ++chunk_offset) {
-            if (compare_function(type_cast<T>((*column)[chunk_offset]), type_cast<T>(_search_value))) {
-              auto const& row_id = (*column->pos_list())[chunk_offset];
-              pos_list->emplace_back(RowID({row_id.chunk_id, row_id.chunk_offset}));
+      const uint64_t chunk_count = _table->chunk_count();
+      const auto max_parallelism = _max_parallelism == 0 ? WorkerPool::get().worker_count() + 1 : _max_parallelism;
+      const auto task_count = std::min(chunk_count, static_cast<uint64_t>(max_parallelism));
+
+      // Chunks without matches stay empty
+      std::vector<Chunk> result_chunks(chunk_count);
+      std::vector<std::function<void()>> tasks;
+      tasks.reserve(task_count);
+      for (size_t task_id = 0; task_id < task_count; ++task_id) {
+        const auto first_chunk_id = ChunkID{static_cast<uint32_t>(chunk_count * task_id / task_count)};
+        const auto end_chunk_id = ChunkID{static_cast<uint32_t>(chunk_count * (task_id + 1) / task_count)};
+        tasks.emplace_back([&, first_chunk_id, end_chunk_id]() {
+          resolve_scan_type(_scan_type, [&](auto type) {
+            for (auto chunk_id = first_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+              const auto matches = std::make_shared<SingleChunkPosList>(SingleChunkPosList{chunk_id, {}});
+              scan_chunk<decltype(type)::value>(chunk_id, matches->chunk_offsets);
+              if (!matches->chunk_offsets.empty()) result_chunks[chunk_id] = create_result_chunk(chunk_id, matches);
             }
+          });
+        });
+      }
+      WorkerPool::get().execute_tasks(tasks, max_parallelism);
+
+      const auto result_table = std::make_shared<Table>(_table->chunk_size());
+      for (ColumnID column_id{0}; column_id < _table->column_count(); ++column_id) {
+        result_table->add_column_definition(_table->column_name(column_id), _table->column_type(column_id));
+      }
+      auto has_matches = false;
+      for (auto& result_chunk : result_chunks) {
+        if (result_chunk.size() == 0) continue;
+        result_table->emplace_chunk(std::move(result_chunk));
+        has_matches = true;
+      }
+
+      // Without matches, the result still has a chunk with a segment per column
+      if (!has_matches) {
+        const auto no_matches = std::make_shared<SingleChunkPosList>(SingleChunkPosList{ChunkID{0}, {}});
+        result_table->emplace_chunk(create_result_chunk(ChunkID{0}, no_matches));
+      }
+      return result_table;
+    }
+
+    // Scans a single chunk of the input table and appends the offsets of the matching rows to matches. scan_type equals
+    // _scan_type.
+    template <ScanType scan_type>
+    void scan_chunk(const ChunkID chunk_index, std::vector<ChunkOffset>& matches) {
+      const auto& chunk = _table->get_chunk(chunk_index);
+      const auto& segment = chunk.get_segment(_column_id);
+      const auto search_value = type_cast<T>(_search_value);
+
+      // Skip the chunk or accept all of its rows if the statistics decide the predicate for the whole segment
+      if (const auto statistics = std::dynamic_pointer_cast<const SegmentStatistics<T>>(
+              chunk.get_statistics(_column_id))) {
+        const auto match = statistics->template match<scan_type>(search_value);
+        if (match == PredicateMatch::None) return;
+        if (match == PredicateMatch::All) {
+          append_offset_range(0, static_cast<ChunkOffset>(segment->size()), matches);
+          return;
+        }
+      }
+
+      if (scan_frame_of_reference_segment<scan_type>(segment, search_value, chunk_index, matches) ||
+          scan_gorilla_segment<scan_type>(segment, search_value, chunk_index, matches) ||
+          scan_contiguous_string_segment<scan_type>(segment, search_value, chunk_index, matches) ||
+          scan_front_coded_dictionary_segment(segment, search_value, chunk_index, matches)) {
+        return;
+      }
+
+      // Determine if the search column in the chunk is a dictionary segment.
+      if (const auto& column = std::dynamic_pointer_cast<DictionarySegment<T>>(segment)) {
+        scan_dictionary_segment(*column, search_value, chunk_index, matches);
+
+        // Determine if the search column in the chunk is a run length segment.
+      } else if (const auto& column = std::dynamic_pointer_cast<RunLengthSegment<T>>(segment)) {
+        // Evaluate the predicate once per run and add all rows of the matching runs.
+        const auto& values = *column->values();
+        const auto& end_positions = *column->end_positions();
+        ChunkOffset run_begin = 0;
+        for (size_t run = 0; run < values.size(); ++run) {
+          const auto run_end = static_cast<ChunkOffset>(end_positions[run] + 1);
+          if (scan_compare<scan_type>(values[run], search_value)) {
+            append_offset_range(run_begin, run_end, matches);
           }
+          run_begin = run_end;
         }
+
+        // Determine if the search column in the chunk is a value segment.
+      } else if (const auto& column = std::dynamic_pointer_cast<ValueSegment<T>>(segment)) {
+        // Compare the values block-wise using the predicate kernels.
+        // Only the first size() values are visible, if the chunk is being appended to
+        const auto& values = column->values();
+        scan_values<scan_type>(values.data(), column->size(), search_value, chunk_index, ChunkOffset{0}, matches);
+
+        // Determine if the search column in the chunk is a reference segment.
+      } else if (std::dynamic_pointer_cast<ReferenceSegment>(segment)) {
+        // The referenced values are read through their typed segments. The matches are offsets in the input chunk,
+        // which create_result_chunk() maps to the referenced rows.
+        auto chunk_offset = ChunkOffset{0};
+        segment_iterate<T>(*segment, [&](const auto& value) {
+          // Strings may be passed as std::string_view, which the search value is converted to
+          using Value = std::decay_t<decltype(value)>;
+          if (scan_compare<scan_type, Value>(value, search_value)) {
+            matches.emplace_back(chunk_offset);
+          }
+          ++chunk_offset;
+        });
+      } else {
+        Fail("Unsupported segment type");
       }
-      return create_result_table(result_size, pos_list);
     }
   };
 
@@ -190,6 +508,7 @@ class TableScan : public AbstractOperator {
   const ColumnID _column_id;
   const ScanType _scan_type;
   const AllTypeVariant _search_value;
+  const size_t _max_parallelism;
 };
 
 }  // namespace opossum
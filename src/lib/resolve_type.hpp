@@ -7,13 +7,14 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "all_type_variant.hpp"
 #include "utils/assert.hpp"
 
-#include "operators/table_scan.hpp"
 #include "storage/value_segment.hpp"
+#include "types.hpp"
 
 namespace opossum {
 
@@ -130,4 +131,36 @@ void resolve_data_type(const std::string& type_string, const Functor& func) {
   });
 }
 
+/**
+ * Resolves a ScanType by passing a std::integral_constant holding it on to a generic lambda. This allows using the
+ * scan type as a template argument, e.g., to instantiate a loop with an inlined comparison per scan type instead of
+ * calling a comparator through a function pointer for every row.
+ *
+ *
+ * Example:
+ *
+ *   resolve_scan_type(scan_type, [&](auto type) {
+ *     constexpr auto resolved_scan_type = decltype(type)::value;
+ *     scan_values<resolved_scan_type>(values, value_count, search_value, chunk_id, ChunkOffset{0}, pos_list);
+ *   });
+ */
+template <typename Functor>
+void resolve_scan_type(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return func(std::integral_constant<ScanType, ScanType::OpEquals>{});
+    case ScanType::OpNotEquals:
+      return func(std::integral_constant<ScanType, ScanType::OpNotEquals>{});
+    case ScanType::OpLessThan:
+      return func(std::integral_constant<ScanType, ScanType::OpLessThan>{});
+    case ScanType::OpLessThanEquals:
+      return func(std::integral_constant<ScanType, ScanType::OpLessThanEquals>{});
+    case ScanType::OpGreaterThan:
+      return func(std::integral_constant<ScanType, ScanType::OpGreaterThan>{});
+    case ScanType::OpGreaterThanEquals:
+      return func(std::integral_constant<ScanType, ScanType::OpGreaterThanEquals>{});
+  }
+  Fail("Unknown scan type");
+}
+
 }  // namespace opossum
@@ -0,0 +1,133 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Shared state of a single execute_tasks() call. Threads claim tasks through an atomic counter, so every task runs
+// exactly once, no matter how many threads join in.
+struct TaskBatch {
+  explicit TaskBatch(const std::vector<std::function<void()>>& batch_tasks)
+      : tasks(batch_tasks), task_count(batch_tasks.size()), pending_task_count(batch_tasks.size()) {}
+
+  // Claims and runs tasks until there are none left. `tasks` is only accessed for claimed tasks. As the caller of
+  // execute_tasks() waits for all tasks to finish, the vector is guaranteed to be alive while we do so.
+  void run() {
+    while (true) {
+      const auto task_id = next_task_id.fetch_add(1);
+      if (task_id >= task_count) return;
+
+      try {
+        tasks[task_id]();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) exception = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--pending_task_count == 0) finished.notify_all();
+    }
+  }
+
+  const std::vector<std::function<void()>>& tasks;
+  const size_t task_count;
+  std::atomic<size_t> next_task_id{0};
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t pending_task_count;
+  std::exception_ptr exception;
+};
+
+}  // namespace
+
+WorkerPool& WorkerPool::get() {
+  static WorkerPool worker_pool(std::max(std::thread::hardware_concurrency(), 1u));
+  return worker_pool;
+}
+
+WorkerPool::WorkerPool(size_t worker_count) {
+  _workers.reserve(worker_count);
+  for (size_t worker_id = 0; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back([&]() { _work(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _condition.notify_all();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+size_t WorkerPool::worker_count() const { return _workers.size(); }
+
+void WorkerPool::execute_tasks(const std::vector<std::function<void()>>& tasks, size_t max_parallelism) {
+  if (tasks.empty()) return;
+
+  if (max_parallelism == 0) max_parallelism = worker_count() + 1;
+  const auto helper_count = std::min({max_parallelism - 1, tasks.size() - 1, worker_count()});
+
+  const auto batch = std::make_shared<TaskBatch>(tasks);
+  for (size_t helper_id = 0; helper_id < helper_count; ++helper_id) {
+    _enqueue([batch]() { batch->run(); });
+  }
+
+  // The calling thread works on its own batch instead of idling. Helpers that are picked up only after the batch is
+  // done simply find no task left.
+  batch->run();
+
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->finished.wait(lock, [&]() { return batch->pending_task_count == 0; });
+
+  if (batch->exception) std::rethrow_exception(batch->exception);
+}
+
+std::future<void> WorkerPool::schedule(std::function<void()> job) {
+  // std::function requires a copyable callable, so the packaged_task is shared
+  const auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+  auto future = task->get_future();
+  _enqueue([task]() { (*task)(); });
+  return future;
+}
+
+void WorkerPool::_enqueue(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    DebugAssert(!_shutdown, "Cannot enqueue jobs into a WorkerPool that is shutting down");
+    _jobs.push(std::move(job));
+  }
+  _condition.notify_one();
+}
+
+void WorkerPool::_work() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _condition.wait(lock, [&]() { return _shutdown || !_jobs.empty(); });
+      if (_shutdown) return;
+
+      job = std::move(_jobs.front());
+      _jobs.pop();
+    }
+    job();
+  }
+}
+
+}  // namespace opossum
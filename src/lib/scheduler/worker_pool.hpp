@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// The WorkerPool is a singleton that owns a fixed set of worker threads, one per hardware thread.
+// Operators hand it a batch of independent tasks and block until all of them are done. The calling thread takes part
+// in executing its own batch, so a batch always makes progress - even if all workers are busy or if execute_tasks()
+// is called from within another task.
+class WorkerPool : private Noncopyable {
+ public:
+  static WorkerPool& get();
+
+  ~WorkerPool();
+
+  // returns the number of worker threads (not counting threads that call execute_tasks)
+  size_t worker_count() const;
+
+  // Executes all tasks and blocks until they have finished. At most max_parallelism threads, including the calling
+  // thread, work on the batch at the same time. A max_parallelism of 0 uses all workers.
+  // If a task throws, the first exception is rethrown once the whole batch has finished.
+  void execute_tasks(const std::vector<std::function<void()>>& tasks, size_t max_parallelism = 0);
+
+  // Runs the job on a worker without waiting for it, e.g., for maintenance such as encoding chunks in the background.
+  // The returned future becomes ready once the job has finished and rethrows its exception, if any.
+  std::future<void> schedule(std::function<void()> job);
+
+  WorkerPool(WorkerPool&&) = delete;
+
+ protected:
+  explicit WorkerPool(size_t worker_count);
+
+  // adds a job to the queue, it will be picked up by the next idle worker
+  void _enqueue(std::function<void()> job);
+
+  // main loop of each worker thread
+  void _work();
+
+  std::vector<std::thread> _workers;
+  std::queue<std::function<void()>> _jobs;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _shutdown = false;
+};
+
+}  // namespace opossum
@@ -28,5 +28,8 @@ class BaseSegment : private Noncopyable {
 
   // returns the number of values
   virtual size_t size() const = 0;
+
+  // returns an estimate of the number of bytes that the segment occupies, including the data it holds on the heap
+  virtual size_t estimate_memory_usage() const = 0;
 };
 }  // namespace opossum
@@ -0,0 +1,46 @@
+#include "bit_packed_attribute_vector.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BitPackedAttributeVector::BitPackedAttributeVector(const size_t size, const uint8_t bit_width)
+    : _values(std::make_shared<BitPackedVector>(size, bit_width)) {
+  Assert(bit_width <= 32, "Value ids do not have more than 32 bits");
+}
+
+BitPackedAttributeVector::BitPackedAttributeVector(std::shared_ptr<BitPackedVector> values)
+    : _values(std::move(values)) {
+  Assert(_values->bit_width() <= 32, "Value ids do not have more than 32 bits");
+}
+
+ValueID BitPackedAttributeVector::get(const size_t i) const {
+  return ValueID{static_cast<ValueID::base_type>(_values->get(i))};
+}
+
+void BitPackedAttributeVector::set(const size_t i, const ValueID value_id) { _values->set(i, value_id); }
+
+size_t BitPackedAttributeVector::size() const { return _values->size(); }
+
+AttributeVectorWidth BitPackedAttributeVector::width() const {
+  return static_cast<AttributeVectorWidth>((_values->bit_width() + 7) / 8);
+}
+
+uint8_t BitPackedAttributeVector::bit_width() const { return _values->bit_width(); }
+
+void BitPackedAttributeVector::decode(const ChunkOffset first_offset, const size_t count,
+                                      ValueID::base_type* out) const {
+  DebugAssert(first_offset + count <= size(), "Cannot decode beyond the end of the attribute vector");
+  _values->decode(first_offset, count, out);
+}
+
+size_t BitPackedAttributeVector::estimate_memory_usage() const {
+  return sizeof(*this) + _values->estimate_memory_usage();
+}
+
+std::shared_ptr<const BitPackedVector> BitPackedAttributeVector::values() const { return _values; }
+
+}  // namespace opossum
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+
+#include "base_attribute_vector.hpp"
+#include "bit_packed_vector.hpp"
+
+namespace opossum {
+
+// BitPackedAttributeVector stores every value id with the same number of bits (1 to 32), e.g., 9 bits for a
+// dictionary with 300 entries where a FittedAttributeVector would need 16.
+class BitPackedAttributeVector : public BaseAttributeVector {
+ public:
+  BitPackedAttributeVector(const size_t size, const uint8_t bit_width);
+
+  // wraps value ids that were packed before
+  explicit BitPackedAttributeVector(std::shared_ptr<BitPackedVector> values);
+  virtual ~BitPackedAttributeVector() = default;
+
+  // returns the value id at a given position
+  ValueID get(const size_t i) const override;
+
+  // sets the value id at a given position
+  void set(const size_t i, const ValueID value_id) override;
+
+  // returns the number of values
+  size_t size() const override;
+
+  // returns the number of bytes needed to store the biggest value id, i.e., the bit width rounded up
+  AttributeVectorWidth width() const override;
+
+  // returns the number of bits per value id
+  uint8_t bit_width() const;
+
+  // returns an estimate of the bytes used
+  size_t estimate_memory_usage() const override;
+
+  // Unpacks the value ids at positions [first_offset, first_offset + count) to out. Scans use this to decode blocks of
+  // value ids at once instead of calling get() per row.
+  void decode(const ChunkOffset first_offset, const size_t count, ValueID::base_type* out) const;
+
+  // returns the packed value ids
+  std::shared_ptr<const BitPackedVector> values() const;
+
+ protected:
+  std::shared_ptr<BitPackedVector> _values;
+};
+
+}  // namespace opossum
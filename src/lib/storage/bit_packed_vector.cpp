@@ -0,0 +1,49 @@
+#include "bit_packed_vector.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BitPackedVector::BitPackedVector(const size_t size, const uint8_t bit_width)
+    : _owned_words((size * bit_width + 63) / 64),
+      _words(_owned_words.data()),
+      _size(size),
+      _bit_width(bit_width),
+      _mask(bit_width == 64 ? ~uint64_t{0} : (uint64_t{1} << bit_width) - 1) {
+  Assert(bit_width >= 1 && bit_width <= 64, "Bit width has to be between 1 and 64");
+}
+
+BitPackedVector::BitPackedVector(const size_t size, const uint8_t bit_width, const uint64_t* words,
+                                 std::shared_ptr<const void> owner)
+    : _words(words),
+      _owner(std::move(owner)),
+      _size(size),
+      _bit_width(bit_width),
+      _mask(bit_width == 64 ? ~uint64_t{0} : (uint64_t{1} << bit_width) - 1) {
+  Assert(bit_width >= 1 && bit_width <= 64, "Bit width has to be between 1 and 64");
+}
+
+uint8_t BitPackedVector::required_bit_width(const uint64_t value) {
+  return value == 0 ? 1 : static_cast<uint8_t>(64 - __builtin_clzll(value));
+}
+
+void BitPackedVector::set(const size_t i, const uint64_t value) {
+  DebugAssert((value & ~_mask) == 0, "Value does not fit into the bit width");
+  DebugAssert(!_owner, "Wrapped bit-packed vectors are read-only");
+
+  const auto bit_index = i * _bit_width;
+  const auto word_index = bit_index / 64;
+  const auto shift = bit_index % 64;
+
+  auto& words = _owned_words;
+  words[word_index] = (words[word_index] & ~(_mask << shift)) | (value << shift);
+  if (shift + _bit_width > 64) {
+    const auto high_mask = _mask >> (64 - shift);
+    words[word_index + 1] = (words[word_index + 1] & ~high_mask) | (value >> (64 - shift));
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A vector of unsigned integers that all occupy the same number of bits (1 to 64). The values are stored back to back
+// in 64 bit words, a value may span two words. Used by compressed segments to store codes or offsets with exactly
+// the width that their largest value needs.
+class BitPackedVector : private Noncopyable {
+ public:
+  BitPackedVector(const size_t size, const uint8_t bit_width);
+
+  // Wraps words that were packed before, e.g., in a memory-mapped snapshot, without copying them. owner keeps the
+  // words alive. Such a vector is read-only.
+  BitPackedVector(const size_t size, const uint8_t bit_width, const uint64_t* words, std::shared_ptr<const void> owner);
+
+  // returns the number of bits needed to store value, at least 1
+  static uint8_t required_bit_width(const uint64_t value);
+
+  // returns the value at a given position
+  uint64_t get(const size_t i) const {
+    const auto bit_index = i * _bit_width;
+    const auto word_index = bit_index / 64;
+    const auto shift = bit_index % 64;
+
+    auto value = _words[word_index] >> shift;
+    if (shift + _bit_width > 64) value |= _words[word_index + 1] << (64 - shift);
+    return value & _mask;
+  }
+
+  // sets the value at a given position, the value has to fit into bit_width bits
+  void set(const size_t i, const uint64_t value);
+
+  // Writes the values at positions [first_index, first_index + count) to out. Other than calling get() per value,
+  // this walks through the words sequentially without recomputing the position of every value.
+  template <typename Out>
+  void decode(const size_t first_index, const size_t count, Out* out) const {
+    const auto first_bit_index = first_index * _bit_width;
+    auto word_index = first_bit_index / 64;
+    auto shift = static_cast<uint32_t>(first_bit_index % 64);
+
+    for (size_t index = 0; index < count; ++index) {
+      auto value = _words[word_index] >> shift;
+      if (shift + _bit_width > 64) value |= _words[word_index + 1] << (64 - shift);
+      out[index] = static_cast<Out>(value & _mask);
+
+      shift += _bit_width;
+      if (shift >= 64) {
+        shift -= 64;
+        ++word_index;
+      }
+    }
+  }
+
+  // returns the number of values
+  size_t size() const { return _size; }
+
+  // returns the number of bits per value
+  uint8_t bit_width() const { return _bit_width; }
+
+  // returns the words that hold the packed values
+  const uint64_t* words() const { return _words; }
+
+  // returns the number of words
+  size_t word_count() const { return (_size * _bit_width + 63) / 64; }
+
+  // returns an estimate of the bytes used, wrapped words are counted although they are not owned
+  size_t estimate_memory_usage() const { return sizeof(*this) + word_count() * sizeof(uint64_t); }
+
+ protected:
+  // empty if the words are owned by _owner
+  std::vector<uint64_t> _owned_words;
+  const uint64_t* _words;
+  std::shared_ptr<const void> _owner;
+  size_t _size;
+  uint8_t _bit_width;
+  uint64_t _mask;
+};
+
+}  // namespace opossum
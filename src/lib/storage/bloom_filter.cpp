@@ -0,0 +1,34 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BloomFilter::BloomFilter(const size_t value_count, const uint32_t bits_per_value)
+    : _blocks(std::max(size_t{1}, (value_count * bits_per_value + block_bit_count - 1) / block_bit_count)),
+      // k = ln(2) * m / n minimizes the false positive rate
+      _hash_count(std::clamp(static_cast<uint32_t>(std::lround(bits_per_value * std::log(2.0))), 1u, 16u)) {
+  Assert(bits_per_value > 0, "A Bloom filter needs at least one bit per value");
+}
+
+BloomFilter::BloomFilter(const uint64_t* words, const size_t word_count, const uint32_t hash_count)
+    : _blocks(word_count / (block_bit_count / 64)), _hash_count(hash_count) {
+  Assert(word_count > 0 && word_count % (block_bit_count / 64) == 0, "A Bloom filter consists of whole blocks");
+  std::memcpy(_blocks.data(), words, word_count * sizeof(uint64_t));
+}
+
+void BloomFilter::insert(const size_t hash) {
+  const auto mixed = _mix(hash);
+  auto& block = _blocks[_block_index(mixed)];
+  const auto probe_hash = _probe_hash(mixed);
+  for (uint32_t index = 0; index < _hash_count; ++index) {
+    const auto bit = _bit_in_block(probe_hash, index);
+    block[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A blocked Bloom filter as described in "Cache-, Hash- and Space-Efficient Bloom Filters" (Putze et al., 2007). All
+// bits of a value are set in one block of 512 bits, i.e., one cache line, so that a lookup causes a single cache miss.
+// Values are added and looked up by their std::hash, which the filter mixes before use.
+class BloomFilter {
+ public:
+  // Creates a filter for value_count values that uses about bits_per_value bits per value. Ten bits per value give a
+  // false positive rate of about one percent.
+  BloomFilter(const size_t value_count, const uint32_t bits_per_value);
+
+  // Restores a filter from the words returned by words(), e.g., when loading a snapshot
+  BloomFilter(const uint64_t* words, const size_t word_count, const uint32_t hash_count);
+
+  // adds the value with the given hash
+  void insert(const size_t hash);
+
+  // returns false if no value with the given hash was added, true if one might have been added
+  bool may_contain(const size_t hash) const {
+    const auto mixed = _mix(hash);
+    const auto& block = _blocks[_block_index(mixed)];
+    const auto probe_hash = _probe_hash(mixed);
+    for (uint32_t index = 0; index < _hash_count; ++index) {
+      const auto bit = _bit_in_block(probe_hash, index);
+      if ((block[bit / 64] & (uint64_t{1} << (bit % 64))) == 0) return false;
+    }
+    return true;
+  }
+
+  // returns the number of bits that the filter occupies
+  size_t bit_count() const { return _blocks.size() * block_bit_count; }
+
+  // returns the number of bits that are set per value
+  uint32_t hash_count() const { return _hash_count; }
+
+  // returns the bits of the filter, as bit_count() / 64 words
+  const uint64_t* words() const { return reinterpret_cast<const uint64_t*>(_blocks.data()); }
+
+ protected:
+  static constexpr uint32_t block_bit_count = 512;
+  using Block = std::array<uint64_t, block_bit_count / 64>;
+
+  // std::hash is the identity for integers, so its result is spread over all 64 bits first (MurmurHash3's finalizer)
+  static uint64_t _mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // The block is chosen by the upper 32 bits of the hash, scaled to the number of blocks
+  size_t _block_index(const uint64_t mixed) const { return ((mixed >> 32) * _blocks.size()) >> 32; }
+
+  // The bits within the block come from a remixed hash, so that they do not depend on the choice of the block
+  static uint64_t _probe_hash(const uint64_t mixed) { return _mix(mixed ^ 0x9e3779b97f4a7c15ULL); }
+
+  // Each bit is taken from the upper nine bits of the probe hash multiplied by an odd constant of its own. Double
+  // hashing within the 512 bits of a block would leave too few distinct combinations of bits for many bits per value.
+  static uint32_t _bit_in_block(const uint64_t probe_hash, const uint32_t index) {
+    static constexpr std::array<uint64_t, 16> salts{
+        0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f5ULL, 0x06c45d188009454fULL, 0xf88bb8a8724c81edULL,
+        0x1b39896a51a8749bULL, 0x53cb9f0c747ea2ebULL, 0x2c829abe1f4532e1ULL, 0xc584133ac916ab3dULL,
+        0x3ee5789041c98ac3ULL, 0xf3b8488c368cb0a7ULL, 0x657eecdd3cb13d09ULL, 0xc2d326e0055bdef7ULL,
+        0x8621a03fe0bbdb7bULL, 0x8e1f7555983aa92fULL, 0xb54e0f1600cc4d19ULL, 0x84bb3f97971d80abULL};
+    return static_cast<uint32_t>((probe_hash * salts[index]) >> 55);
+  }
+
+  std::vector<Block> _blocks;
+  uint32_t _hash_count;
+};
+
+}  // namespace opossum
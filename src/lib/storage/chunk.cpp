@@ -1,32 +1,131 @@
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "segment_statistics.hpp"
 
 #include "utils/assert.hpp"
 
 namespace opossum {
 
-void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) { _segments.push_back(segment); }
+void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) {
+  auto segments = *_segments;
+  segments.push_back(segment);
+  _segments = std::make_shared<const Segments>(std::move(segments));
+}
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
   DebugAssert(values.size() == column_count(), "Wrong number of entries");
+  DebugAssert(!_append_state, "Chunks that are appended to concurrently are written by Table::append");
   for (size_t index = 0; index < values.size(); ++index) {
-    _segments[index]->append(values[index]);
+    (*_segments)[index]->append(values[index]);
   }
 }
 
-std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const { return _segments[column_id]; }
+std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const { return (*segments())[column_id]; }
+
+std::shared_ptr<const Chunk::Segments> Chunk::segments() const { return std::atomic_load(&_segments); }
+
+void Chunk::replace_segments(Segments segments) {
+  DebugAssert(segments.size() == column_count(), "Wrong number of segments");
+  DebugAssert(segments.empty() || segments[0]->size() == size(), "Replaced segments have to hold the same values");
+  std::atomic_store(&_segments, std::make_shared<const Segments>(std::move(segments)));
+}
+
+void Chunk::set_statistics(std::vector<std::shared_ptr<BaseSegmentStatistics>> statistics) {
+  DebugAssert(statistics.size() == column_count(), "Wrong number of statistics");
+  std::atomic_store(&_statistics, std::make_shared<const std::vector<std::shared_ptr<BaseSegmentStatistics>>>(
+                                      std::move(statistics)));
+}
+
+std::shared_ptr<const BaseSegmentStatistics> Chunk::get_statistics(ColumnID column_id) const {
+  const auto statistics = std::atomic_load(&_statistics);
+  return statistics ? (*statistics)[column_id] : nullptr;
+}
+
+bool Chunk::has_statistics() const { return static_cast<bool>(std::atomic_load(&_statistics)); }
+
+void Chunk::set_append_capacity(ChunkOffset capacity) {
+  if (!_append_state) _append_state = std::make_shared<AppendState>();
+  DebugAssert(capacity >= _append_state->capacity, "The capacity of a chunk cannot shrink");
+  DebugAssert(_append_state->visible_row_count == _append_state->reserved_row_count, "Rows are still being written");
+  // Writers that see the new capacity also see the segments that hold it
+  _append_state->capacity.store(capacity, std::memory_order_release);
+}
+
+ChunkOffset Chunk::append_capacity() const {
+  return _append_state ? _append_state->capacity.load(std::memory_order_acquire) : 0;
+}
+
+bool Chunk::accepts_appends() const { return _append_state && _append_state->accepts_appends; }
+
+std::shared_ptr<const std::atomic<ChunkOffset>> Chunk::visible_row_count() const {
+  DebugAssert(static_cast<bool>(_append_state), "The chunk is not appended to concurrently");
+  // Shares the ownership of the append state
+  return std::shared_ptr<const std::atomic<ChunkOffset>>(_append_state, &_append_state->visible_row_count);
+}
+
+std::pair<ChunkOffset, ChunkOffset> Chunk::reserve_rows(ChunkOffset count) {
+  if (!_append_state) return {size(), 0};
+
+  auto reserved_row_count = _append_state->reserved_row_count.load();
+  while (true) {
+    const auto capacity = _append_state->capacity.load(std::memory_order_acquire);
+    if (reserved_row_count >= capacity) return {reserved_row_count, 0};
+
+    const auto reserved_count = std::min(count, capacity - reserved_row_count);
+    if (_append_state->reserved_row_count.compare_exchange_weak(reserved_row_count,
+                                                                reserved_row_count + reserved_count)) {
+      return {reserved_row_count, reserved_count};
+    }
+  }
+}
+
+void Chunk::publish_rows(ChunkOffset offset, ChunkOffset count) {
+  // Writers that reserved rows before ours may still be writing them
+  _wait_for_visible_rows(offset);
+  _append_state->visible_row_count.store(offset + count, std::memory_order_release);
+}
+
+void Chunk::wait_for_reserved_rows() const {
+  DebugAssert(accepts_appends(), "The rows of a finished chunk are all visible");
+  _wait_for_visible_rows(_append_state->reserved_row_count);
+}
+
+ChunkOffset Chunk::finish_appends() {
+  if (!accepts_appends()) return size();
+  _append_state->accepts_appends = false;
+  // Reserving the remaining rows lets all further reservations fail
+  const auto row_count = reserve_rows(std::numeric_limits<ChunkOffset>::max()).first;
+  _wait_for_visible_rows(row_count);
+  return row_count;
+}
+
+void Chunk::_wait_for_visible_rows(ChunkOffset row_count) const {
+  while (_append_state->visible_row_count.load(std::memory_order_acquire) != row_count) {
+    std::this_thread::yield();
+  }
+}
+
+size_t Chunk::estimate_memory_usage() const {
+  auto bytes = sizeof(*this);
+  for (const auto& segment : *segments()) {
+    bytes += segment->estimate_memory_usage();
+  }
+  return bytes;
+}
 
-uint16_t Chunk::column_count() const { return _segments.size(); }
+uint16_t Chunk::column_count() const { return segments()->size(); }
 
-uint32_t Chunk::size() const { return column_count() <= 0 ? 0 : _segments[0]->size(); }
+uint32_t Chunk::size() const { return column_count() <= 0 ? 0 : get_segment(ColumnID{0})->size(); }
 
 }  // namespace opossum
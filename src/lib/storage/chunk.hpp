@@ -6,6 +6,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
@@ -15,13 +16,23 @@ namespace opossum {
 
 class BaseIndex;
 class BaseSegment;
+class BaseSegmentStatistics;
 
 // A chunk is a horizontal partition of a table.
 // For each column in the table, it holds one segment. The segments across all chunks constitute the column.
+// Segments and statistics may be replaced while other threads read the chunk, e.g., when it is encoded in the
+// background. All segments of the chunk are replaced at once, so readers that get them via segments() see either all
+// old or all new segments. Both hold the same values.
+//
+// Chunks that a Table appends to can be written by many threads at once: a writer reserves rows (reserve_rows), writes
+// them into the ValueSegments, whose rows are allocated up front, and publishes them (publish_rows). Rows become
+// visible in the order of their reservation, so that readers never see rows that are still being written.
 //
 // Find more information about this in our wiki: https://github.com/hyrise/hyrise/wiki/chunk-concept
 class Chunk : private Noncopyable {
  public:
+  using Segments = std::vector<std::shared_ptr<BaseSegment>>;
+
   Chunk() = default;
 
   // we need to explicitly set the move constructor to default when
@@ -36,17 +47,75 @@ class Chunk : private Noncopyable {
   uint16_t column_count() const;
 
   // returns the number of rows (cannot exceed ChunkOffset (uint32_t))
+  // for chunks that are appended to concurrently, this is the number of visible rows, which their segments report
   uint32_t size() const;
 
   // adds a new row, given as a list of values, to the chunk
   // note this is slow and not thread-safe and should be used for testing purposes only
   void append(const std::vector<AllTypeVariant>& values);
 
+  // Allows concurrent appends to the first capacity rows. The capacity can only grow, and the segments have to be
+  // ValueSegments that share visible_row_count() and hold capacity rows. Must not be called while rows are reserved.
+  void set_append_capacity(ChunkOffset capacity);
+
+  // returns the number of rows that can be reserved in total, 0 if the chunk is not appended to concurrently
+  ChunkOffset append_capacity() const;
+
+  // returns whether rows can still be reserved once the capacity has grown, i.e., finish_appends() was not called
+  bool accepts_appends() const;
+
+  // The number of visible rows, shared with the ValueSegments of a chunk that is appended to concurrently
+  std::shared_ptr<const std::atomic<ChunkOffset>> visible_row_count() const;
+
+  // Reserves up to count rows without locking. Returns the offset of the first reserved row and the number of reserved
+  // rows, which is smaller than count if the capacity is exhausted.
+  std::pair<ChunkOffset, ChunkOffset> reserve_rows(ChunkOffset count);
+
+  // Makes the reserved rows [offset, offset + count) visible, once all rows before them are visible
+  void publish_rows(ChunkOffset offset, ChunkOffset count);
+
+  // Blocks until all reserved rows are visible
+  void wait_for_reserved_rows() const;
+
+  // Reserves the remaining capacity, so that no rows can be appended anymore, and waits until all reserved rows are
+  // visible. Returns the number of rows.
+  ChunkOffset finish_appends();
+
   // Returns the segment at a given position
   std::shared_ptr<BaseSegment> get_segment(ColumnID column_id) const;
 
+  // Returns all segments. Unlike consecutive calls to get_segment(), they are never a mix of replaced and new ones.
+  std::shared_ptr<const Segments> segments() const;
+
+  // Atomically replaces all segments with ones that hold the same values, e.g., encoded ones
+  void replace_segments(Segments segments);
+
+  // sets the statistics of all segments, e.g., once the chunk is full. They have to be replaced if rows are appended.
+  void set_statistics(std::vector<std::shared_ptr<BaseSegmentStatistics>> statistics);
+
+  // returns the statistics of the segment at a given position, or nullptr if the chunk has no statistics
+  std::shared_ptr<const BaseSegmentStatistics> get_statistics(ColumnID column_id) const;
+
+  // returns whether statistics were set
+  bool has_statistics() const;
+
+  // returns an estimate of the number of bytes that the segments of the chunk occupy
+  size_t estimate_memory_usage() const;
+
  protected:
-  std::vector<std::shared_ptr<BaseSegment>> _segments;
+  void _wait_for_visible_rows(ChunkOffset row_count) const;
+
+  struct AppendState {
+    std::atomic<ChunkOffset> capacity{0};
+    std::atomic<ChunkOffset> reserved_row_count{0};
+    std::atomic<ChunkOffset> visible_row_count{0};
+    std::atomic<bool> accepts_appends{true};
+  };
+
+  std::shared_ptr<const Segments> _segments = std::make_shared<const Segments>();
+  std::shared_ptr<const std::vector<std::shared_ptr<BaseSegmentStatistics>>> _statistics;
+  // nullptr if the chunk is not appended to concurrently
+  std::shared_ptr<AppendState> _append_state;
 };
 
 }  // namespace opossum
@@ -0,0 +1,50 @@
+#include "chunk_list.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ChunkList::ChunkList(ChunkList&& other) : _blocks(std::move(other._blocks)), _size(other._size.exchange(0)) {}
+
+size_t ChunkList::size() const { return _size.load(std::memory_order_acquire); }
+
+const std::shared_ptr<Chunk>& ChunkList::operator[](const size_t index) const {
+  DebugAssert(index < size(), "Chunk index out of range");
+  return _entry(index);
+}
+
+const std::shared_ptr<Chunk>& ChunkList::back() const { return (*this)[size() - 1]; }
+
+void ChunkList::push_back(std::shared_ptr<Chunk> chunk) {
+  const auto index = _size.load(std::memory_order_relaxed);
+  const auto block = _block(index);
+  Assert(block < block_count, "Too many chunks");
+
+  // Readers do not access the new entry before the size is increased
+  if (!_blocks[block]) {
+    _blocks[block] = std::make_unique<std::shared_ptr<Chunk>[]>(size_t{1} << (first_block_bits + block));
+  }
+  _entry(index) = std::move(chunk);
+  _size.store(index + 1, std::memory_order_release);
+}
+
+void ChunkList::replace(const size_t index, std::shared_ptr<Chunk> chunk) {
+  DebugAssert(index < size(), "Chunk index out of range");
+  _entry(index) = std::move(chunk);
+}
+
+size_t ChunkList::_block(const size_t index) {
+  // Block b holds the entries whose index + 2^first_block_bits lies in [2^(first_block_bits + b), 2^(... + b + 1))
+  const auto position = index + (size_t{1} << first_block_bits);
+  return static_cast<size_t>(63 - __builtin_clzll(position)) - first_block_bits;
+}
+
+std::shared_ptr<Chunk>& ChunkList::_entry(const size_t index) const {
+  const auto block = _block(index);
+  return _blocks[block][index + (size_t{1} << first_block_bits) - (size_t{1} << (first_block_bits + block))];
+}
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+// An append-only list of chunks. Other than a std::vector, it never moves the entries that it holds: they are stored in
+// blocks of doubling size, which are allocated as the list grows. Threads can therefore read the list while another
+// thread appends to it. Only one thread may append at a time.
+class ChunkList : private Noncopyable {
+ public:
+  ChunkList() = default;
+
+  // must not be used while other threads access the list
+  ChunkList(ChunkList&& other);
+
+  // returns the number of chunks
+  size_t size() const;
+
+  // returns the chunk at a given position, which has to be smaller than size()
+  const std::shared_ptr<Chunk>& operator[](const size_t index) const;
+
+  // returns the last chunk, the list must not be empty
+  const std::shared_ptr<Chunk>& back() const;
+
+  // adds a chunk to the end and makes it visible to readers
+  void push_back(std::shared_ptr<Chunk> chunk);
+
+  // replaces the chunk at a given position. Readers must not access this position at the same time.
+  void replace(const size_t index, std::shared_ptr<Chunk> chunk);
+
+ protected:
+  // The first block holds 2^first_block_bits entries, every further block twice as many as its predecessor
+  static constexpr size_t first_block_bits = 4;
+  // Enough blocks for every ChunkID
+  static constexpr size_t block_count = 32;
+
+  // returns the block that holds the entry at a given position
+  static size_t _block(const size_t index);
+
+  std::shared_ptr<Chunk>& _entry(const size_t index) const;
+
+  std::array<std::unique_ptr<std::shared_ptr<Chunk>[]>, block_count> _blocks;
+  std::atomic<size_t> _size{0};
+};
+
+}  // namespace opossum
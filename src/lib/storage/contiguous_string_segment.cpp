@@ -0,0 +1,71 @@
+#include "contiguous_string_segment.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+ContiguousStringSegment::ContiguousStringSegment(const ValueSpan<std::string>& values) {
+  auto character_count = size_t{0};
+  for (const auto& value : values) {
+    character_count += value.size();
+  }
+
+  _owned_characters.reserve(character_count);
+  _owned_end_offsets.reserve(values.size());
+  for (const auto& value : values) {
+    _owned_characters.insert(_owned_characters.end(), value.cbegin(), value.cend());
+    _owned_end_offsets.emplace_back(_owned_characters.size());
+  }
+
+  _characters = _owned_characters.data();
+  _end_offsets = _owned_end_offsets.data();
+  _size = values.size();
+}
+
+ContiguousStringSegment::ContiguousStringSegment(std::vector<char>&& characters, std::vector<uint64_t>&& end_offsets)
+    : _owned_characters(std::move(characters)),
+      _owned_end_offsets(std::move(end_offsets)),
+      _characters(_owned_characters.data()),
+      _end_offsets(_owned_end_offsets.data()),
+      _size(_owned_end_offsets.size()) {
+  DebugAssert(_owned_end_offsets.empty() || _owned_end_offsets.back() == _owned_characters.size(),
+              "The last string has to end at the end of the characters");
+}
+
+ContiguousStringSegment::ContiguousStringSegment(const char* characters, const uint64_t* end_offsets,
+                                                 const size_t size, std::shared_ptr<const void> owner)
+    : _characters(characters), _end_offsets(end_offsets), _size(size), _owner(std::move(owner)) {}
+
+const AllTypeVariant ContiguousStringSegment::operator[](const size_t i) const {
+  PerformanceWarning("operator[] used");
+  DebugAssert(i < _size, "Offset out of range");
+  return std::string{get(i)};
+}
+
+void ContiguousStringSegment::append(const AllTypeVariant&) {
+  throw std::runtime_error("ContiguousString segments are immutable");
+}
+
+size_t ContiguousStringSegment::size() const { return _size; }
+
+size_t ContiguousStringSegment::estimate_memory_usage() const {
+  if (!_owner) {
+    return sizeof(*this) + _owned_characters.capacity() + _owned_end_offsets.capacity() * sizeof(uint64_t);
+  }
+  return sizeof(*this) + character_count() + _size * sizeof(uint64_t);
+}
+
+const char* ContiguousStringSegment::characters() const { return _characters; }
+
+size_t ContiguousStringSegment::character_count() const { return _size == 0 ? 0 : _end_offsets[_size - 1]; }
+
+const uint64_t* ContiguousStringSegment::end_offsets() const { return _end_offsets; }
+
+}  // namespace opossum
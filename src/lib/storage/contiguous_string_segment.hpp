@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "types.hpp"
+#include "value_span.hpp"
+
+namespace opossum {
+
+// A read-only view on strings that are stored one after another: string i consists of the characters
+// [end_offsets[i - 1], end_offsets[i]), the first string starts at 0. The view does not own the strings.
+class ContiguousStrings {
+ public:
+  ContiguousStrings(const char* characters, const uint64_t* end_offsets, const size_t size)
+      : _characters(characters), _end_offsets(end_offsets), _size(size) {}
+
+  std::string_view operator[](const size_t i) const {
+    const auto begin = i == 0 ? uint64_t{0} : _end_offsets[i - 1];
+    return std::string_view{_characters + begin, _end_offsets[i] - begin};
+  }
+
+  size_t size() const { return _size; }
+
+ protected:
+  const char* _characters;
+  const uint64_t* _end_offsets;
+  size_t _size;
+};
+
+// ContiguousStringSegment stores the characters of all its strings in a single buffer and the end offset of every
+// string in a second one, like the string layout of Apache Arrow. A ValueSegment<std::string> allocates every string
+// that does not fit into the small string buffer on its own; this segment needs two allocations in total, and scans
+// read the characters sequentially instead of following a pointer per row. The segment is immutable.
+class ContiguousStringSegment : public BaseSegment {
+ public:
+  // copies the strings
+  explicit ContiguousStringSegment(const ValueSpan<std::string>& values);
+
+  // takes over strings that are already laid out contiguously, e.g., by a loader
+  ContiguousStringSegment(std::vector<char>&& characters, std::vector<uint64_t>&& end_offsets);
+
+  // Wraps strings that are stored elsewhere, e.g., in a memory-mapped snapshot, without copying them. owner keeps them
+  // alive.
+  ContiguousStringSegment(const char* characters, const uint64_t* end_offsets, const size_t size,
+                          std::shared_ptr<const void> owner);
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override;
+
+  // return the string at a certain position, which points into the segment
+  std::string_view get(const size_t i) const { return strings()[i]; }
+
+  // contiguous string segments are immutable
+  void append(const AllTypeVariant&) override;
+
+  // return the number of entries
+  size_t size() const override;
+
+  // return an estimate of the bytes used, wrapped strings are counted although they are not owned
+  size_t estimate_memory_usage() const override;
+
+  // returns a view on all strings, e.g., for scans that iterate over them
+  ContiguousStrings strings() const { return ContiguousStrings{_characters, _end_offsets, _size}; }
+
+  // returns the characters of all strings, without separators
+  const char* characters() const;
+  size_t character_count() const;
+
+  // returns the end offset of every string in characters()
+  const uint64_t* end_offsets() const;
+
+ protected:
+  // empty if the strings are owned by _owner
+  std::vector<char> _owned_characters;
+  std::vector<uint64_t> _owned_end_offsets;
+
+  const char* _characters;
+  const uint64_t* _end_offsets;
+  size_t _size;
+  std::shared_ptr<const void> _owner;
+};
+
+}  // namespace opossum
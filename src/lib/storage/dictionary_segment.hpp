@@ -1,18 +1,28 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
-#include <set>
 #include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "bit_packed_attribute_vector.hpp"
+#include "contiguous_string_segment.hpp"
+#include "encoding_type.hpp"
+#include "eytzinger_index.hpp"
 #include "fitted_attribute_vector.hpp"
+#include "scheduler/worker_pool.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
 #include "value_segment.hpp"
 
 namespace opossum {
@@ -29,38 +39,104 @@ template <typename T>
 class DictionarySegment : public BaseSegment {
  public:
   /**
-   * Creates a Dictionary segment from a given value segment.
+   * Creates a Dictionary segment from a given value segment, or from a ContiguousStringSegment for strings.
+   * vector_compression determines the type of the attribute vector.
    */
-  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment)
+  explicit DictionarySegment(
+      const std::shared_ptr<BaseSegment>& base_segment,
+      const VectorCompressionType vector_compression = VectorCompressionType::FixedSizeByteAligned)
       : _dictionary(std::make_shared<std::vector<T>>()) {
+    if constexpr (std::is_same<T, std::string>::value) {
+      if (const auto string_segment = std::dynamic_pointer_cast<ContiguousStringSegment>(base_segment)) {
+        _encode(string_segment->strings(), vector_compression);
+        return;
+      }
+    }
+
     const auto& value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    DebugAssert(static_cast<bool>(value_segment), "Dictionary segments can only be created from value segments");
+    _encode(value_segment->values(), vector_compression);
+  }
+
+  /**
+   * Creates a Dictionary segment from a dictionary and an attribute vector that were encoded before, e.g., when
+   * loading a snapshot.
+   */
+  DictionarySegment(std::shared_ptr<std::vector<T>> dictionary, std::shared_ptr<BaseAttributeVector> attribute_vector)
+      : _dictionary(std::move(dictionary)), _attribute_vector(std::move(attribute_vector)) {
+    _create_search_index();
+  }
+
+  /**
+   * Assigns value ids to values, which holds the rows as T or, for strings, as std::string or std::string_view, and
+   * returns the attribute vector that stores them. The distinct values are passed to create_dictionary in sorted order
+   * as a std::vector, for strings as std::string_views into values, so that a dictionary of another type, e.g., a
+   * FrontCodedDictionary, can be built without copying every distinct string first.
+   */
+  template <typename Values, typename CreateDictionary>
+  static std::shared_ptr<BaseAttributeVector> encode_value_ids(const Values& values,
+                                                               const VectorCompressionType vector_compression,
+                                                               const CreateDictionary& create_dictionary) {
+    using Value = std::conditional_t<std::is_same<T, std::string>::value, std::string_view, T>;
+    const auto size = values.size();
 
-    // Remove duplicates using a set
-    std::set<T> deduplicated_set(value_segment->values().cbegin(), value_segment->values().cend());
-    _dictionary->assign(deduplicated_set.cbegin(), deduplicated_set.cend());
-
-    if (_dictionary->size() <= std::numeric_limits<uint8_t>::max()) {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint8_t>>(base_segment->size());
-    } else if (_dictionary->size() <= std::numeric_limits<uint16_t>::max()) {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint16_t>>(base_segment->size());
-    } else if (_dictionary->size() <= std::numeric_limits<uint32_t>::max()) {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint32_t>>(base_segment->size());
-    } else {
-      _attribute_vector = std::make_shared<FittedAttributeVector<uint64_t>>(base_segment->size());
+    // Deduplicate the values through a hash map that assigns preliminary ids in order of appearance. Other than
+    // inserting the values into a tree and searching every row in the dictionary afterwards, this hashes each row once.
+    auto preliminary_ids = std::unordered_map<Value, ValueID::base_type>{};
+    auto rows = std::vector<ValueID::base_type>(size);
+    for (size_t row = 0; row < size; ++row) {
+      // Consecutive duplicates, e.g., in sorted or clustered columns, do not need to be hashed again
+      if (row > 0 && values[row] == values[row - 1]) {
+        rows[row] = rows[row - 1];
+        continue;
+      }
+      const auto next_id = static_cast<ValueID::base_type>(preliminary_ids.size());
+      rows[row] = preliminary_ids.try_emplace(Value{values[row]}, next_id).first->second;
     }
 
-    std::sort(_dictionary->begin(), _dictionary->end());
+    // Sort the distinct values and map the preliminary ids to their final value ids
+    auto entries = std::vector<const std::pair<const Value, ValueID::base_type>*>{};
+    entries.reserve(preliminary_ids.size());
+    for (const auto& entry : preliminary_ids) {
+      entries.emplace_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
 
-    // Insert references to dict into attribute vector
-    for (size_t segment_idx = 0; segment_idx < base_segment->size(); ++segment_idx) {
-      const auto& dict_it =
-          std::lower_bound(_dictionary->cbegin(), _dictionary->cend(), type_cast<T>((*value_segment)[segment_idx]));
+    auto value_ids = std::vector<ValueID::base_type>(entries.size());
+    auto distinct_values = std::vector<Value>{};
+    distinct_values.reserve(entries.size());
+    for (const auto* entry : entries) {
+      value_ids[entry->second] = static_cast<ValueID::base_type>(distinct_values.size());
+      distinct_values.emplace_back(entry->first);
+    }
+    create_dictionary(distinct_values);
 
-      if (dict_it != _dictionary->cend()) {
-        _attribute_vector->set(segment_idx, ValueID{dict_it - _dictionary->cbegin()});
-      }
+    // Creates the attribute vector and fills it. The concrete type is passed on, so that set() is not called through
+    // the BaseAttributeVector interface.
+    const auto encode = [&](const auto& attribute_vector) -> std::shared_ptr<BaseAttributeVector> {
+      _encode_values(rows, value_ids, *attribute_vector);
+      return attribute_vector;
+    };
+
+    const auto distinct_count = distinct_values.size();
+    if (vector_compression == VectorCompressionType::BitPacked) {
+      // The largest value id is the number of distinct values minus one
+      const auto max_value_id = distinct_count == 0 ? size_t{0} : distinct_count - 1;
+      const auto bit_width = BitPackedVector::required_bit_width(max_value_id);
+      return encode(std::make_shared<BitPackedAttributeVector>(size, bit_width));
+    } else if (distinct_count <= std::numeric_limits<uint8_t>::max()) {
+      return encode(std::make_shared<FittedAttributeVector<uint8_t>>(size));
+    } else if (distinct_count <= std::numeric_limits<uint16_t>::max()) {
+      return encode(std::make_shared<FittedAttributeVector<uint16_t>>(size));
     }
+    return encode(std::make_shared<FittedAttributeVector<uint32_t>>(size));
   }
+
+  // Numeric dictionaries with at least this many values are searched through an EytzingerIndex, which is several times
+  // faster than std::lower_bound for them (see hyriseDictionarySearchBenchmark). For smaller dictionaries, a search
+  // takes too little time to make up for the memory of the index.
+  static constexpr size_t search_index_min_size = 1024;
+
   // SEMINAR INFORMATION: Since most of these methods depend on the template parameter, you will have to implement
   // the DictionarySegment in this file. Replace the method signatures with actual implementations.
 
@@ -80,11 +156,15 @@ class DictionarySegment : public BaseSegment {
   std::shared_ptr<const BaseAttributeVector> attribute_vector() const { return _attribute_vector; }
 
   // return the value represented by a given ValueID
-  const T& value_by_value_id(ValueID value_id) const { return _dictionary[value_id]; }
+  const T& value_by_value_id(ValueID value_id) const { return (*_dictionary)[value_id]; }
 
   // returns the first value ID that refers to a value >= the search value
   // returns INVALID_VALUE_ID if all values are smaller than the search value
   ValueID lower_bound(T value) const {
+    if (_search_index) {
+      const auto index = _search_index->lower_bound(value);
+      return index == _dictionary->size() ? INVALID_VALUE_ID : ValueID{index};
+    }
     const auto& low = std::lower_bound(_dictionary->cbegin(), _dictionary->cend(), value);
     return (low == _dictionary->cend()) ? INVALID_VALUE_ID : ValueID{std::distance(_dictionary->cbegin(), low)};
   }
@@ -95,6 +175,10 @@ class DictionarySegment : public BaseSegment {
   // returns the first value ID that refers to a value > the search value
   // returns INVALID_VALUE_ID if all values are smaller than or equal to the search value
   ValueID upper_bound(T value) const {
+    if (_search_index) {
+      const auto index = _search_index->upper_bound(value);
+      return index == _dictionary->size() ? INVALID_VALUE_ID : ValueID{index};
+    }
     const auto& up = std::upper_bound(_dictionary->cbegin(), _dictionary->cend(), value);
     return (up == _dictionary->cend()) ? INVALID_VALUE_ID : ValueID{std::distance(_dictionary->cbegin(), up)};
   }
@@ -108,9 +192,67 @@ class DictionarySegment : public BaseSegment {
   // return the number of entries
   size_t size() const override { return _attribute_vector->size(); }
 
+  // return an estimate of the bytes used by the dictionary, its search index, and the attribute vector
+  size_t estimate_memory_usage() const override {
+    return sizeof(*this) + estimate_vector_memory_usage(*_dictionary) + _attribute_vector->estimate_memory_usage() +
+           (_search_index ? _search_index->estimate_memory_usage() : 0);
+  }
+
  protected:
+  // Minimum number of rows that a task of _encode_values() handles. It is a multiple of 64, so that two tasks never
+  // write into the same 64 bit word of a BitPackedAttributeVector.
+  static constexpr size_t _rows_per_encoding_task = 64 * 1024;
+
+  // Builds the dictionary and the attribute vector from values, which holds the rows as T or, for strings, as
+  // std::string_view. Only the distinct values are copied into the dictionary.
+  template <typename Values>
+  void _encode(const Values& values, const VectorCompressionType vector_compression) {
+    _attribute_vector = encode_value_ids(values, vector_compression, [&](const auto& distinct_values) {
+      _dictionary->reserve(distinct_values.size());
+      for (const auto& value : distinct_values) {
+        _dictionary->emplace_back(T{value});
+      }
+    });
+    _create_search_index();
+  }
+
+  void _create_search_index() {
+    if constexpr (std::is_arithmetic<T>::value) {
+      if (_dictionary->size() >= search_index_min_size) {
+        _search_index = std::make_shared<EytzingerIndex<T>>(*_dictionary);
+      }
+    }
+  }
+
+  // Stores the value id of every row, given as value_ids[rows[row]], in the attribute vector. Ranges of rows are
+  // encoded in parallel.
+  template <typename AttributeVector>
+  static void _encode_values(const std::vector<ValueID::base_type>& rows,
+                             const std::vector<ValueID::base_type>& value_ids, AttributeVector& attribute_vector) {
+    const auto range_count = std::min((rows.size() + _rows_per_encoding_task - 1) / _rows_per_encoding_task,
+                                      WorkerPool::get().worker_count() + 1);
+    if (range_count == 0) return;
+
+    // Round the range size up to a multiple of 64 rows, see _rows_per_encoding_task
+    const auto rows_per_range = ((rows.size() + range_count - 1) / range_count + 63) / 64 * 64;
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(range_count);
+    for (size_t range_begin = 0; range_begin < rows.size(); range_begin += rows_per_range) {
+      const auto range_end = std::min(rows.size(), range_begin + rows_per_range);
+      tasks.emplace_back([&, range_begin, range_end]() {
+        for (auto row = range_begin; row < range_end; ++row) {
+          attribute_vector.set(row, ValueID{value_ids[rows[row]]});
+        }
+      });
+    }
+    WorkerPool::get().execute_tasks(tasks);
+  }
+
   std::shared_ptr<std::vector<T>> _dictionary;
   std::shared_ptr<BaseAttributeVector> _attribute_vector;
+  // only set for large numeric dictionaries, see search_index_min_size
+  std::shared_ptr<const EytzingerIndex<T>> _search_index;
 };
 
 }  // namespace opossum
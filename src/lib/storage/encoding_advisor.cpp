@@ -0,0 +1,272 @@
+#include "encoding_advisor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bit_packed_vector.hpp"
+#include "contiguous_string_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary.hpp"
+#include "gorilla_segment.hpp"
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace {
+
+// An encoding that comes later in the order of preference has to make the segment this much smaller to be chosen
+constexpr double preference_margin = 0.9;
+
+// Bytes that a std::string with the given characters allocates on the heap, if they do not fit into the string itself
+size_t string_heap_bytes(const std::string_view value) {
+  static const auto inline_capacity = std::string{}.capacity();
+  return value.size() > inline_capacity ? value.size() + 1 : 0;
+}
+
+// Profiles the first row_count values, which are of type T or, for strings, std::string_views into a
+// ContiguousStringSegment
+template <typename T, typename Values>
+SegmentProfile profile_values(const Values& values, const size_t row_count) {
+  using Value = std::decay_t<decltype(values[0])>;
+  auto profile = SegmentProfile{};
+  profile.row_count = row_count;
+  if (profile.row_count == 0) return profile;
+
+  // Sample runs of consecutive rows that are spread evenly over the segment. Small segments are sampled completely.
+  auto run_count = encoding_sample_run_count;
+  auto run_length = encoding_sample_run_length;
+  if (profile.row_count <= run_count * run_length) {
+    run_count = 1;
+    run_length = profile.row_count;
+  }
+
+  auto sample = std::vector<Value>{};
+  sample.reserve(run_count * run_length);
+  size_t value_change_count = 0;
+  for (size_t run = 0; run < run_count; ++run) {
+    const auto begin = run_count == 1 ? size_t{0} : run * (profile.row_count - run_length) / (run_count - 1);
+    for (auto row = begin; row < begin + run_length; ++row) {
+      if (row > begin && !(values[row] == values[row - 1])) ++value_change_count;
+      sample.emplace_back(values[row]);
+    }
+  }
+  profile.sampled_row_count = sample.size();
+
+  // The distinct values of the segment are estimated with Shlosser's estimator, which Haas et al. ("Sampling-Based
+  // Estimation of the Number of Distinct Values of an Attribute", VLDB 1995) recommend for data of low skew. It
+  // extrapolates from the values that occur once in the sample, e.g., a sample of unique values suggests unique rows.
+  auto frequencies = std::unordered_map<Value, size_t>{};
+  for (const auto& value : sample) {
+    ++frequencies[value];
+  }
+  auto frequency_counts = std::unordered_map<size_t, size_t>{};
+  for (const auto& entry : frequencies) {
+    ++frequency_counts[entry.second];
+  }
+  const auto sampled_fraction = static_cast<double>(sample.size()) / static_cast<double>(profile.row_count);
+  auto numerator = 0.0;
+  auto denominator = 0.0;
+  for (const auto& [frequency, count] : frequency_counts) {
+    numerator += std::pow(1.0 - sampled_fraction, frequency) * static_cast<double>(count);
+    denominator += static_cast<double>(frequency) * sampled_fraction *
+                   std::pow(1.0 - sampled_fraction, frequency - 1) * static_cast<double>(count);
+  }
+  const auto singleton_count = static_cast<double>(frequency_counts[1]);
+  auto estimated_distinct_count = frequencies.size();
+  if (singleton_count > 0 && sampled_fraction < 1.0) {
+    estimated_distinct_count += static_cast<size_t>(std::lround(singleton_count * numerator / denominator));
+  }
+  profile.distinct_count = std::min(estimated_distinct_count, profile.row_count);
+
+  // Every row but the first of the segment starts a new run with the probability observed within the sampled runs
+  const auto sampled_neighbour_count = sample.size() - run_count;
+  profile.run_count = sampled_neighbour_count == 0
+                          ? 1
+                          : 1 + static_cast<size_t>(std::lround(static_cast<double>(value_change_count) *
+                                                                static_cast<double>(profile.row_count - 1) /
+                                                                static_cast<double>(sampled_neighbour_count)));
+
+  // Encodings store strings as std::string, a ContiguousStringSegment stores their characters and an end offset
+  profile.value_bytes = sizeof(T);
+  profile.unencoded_value_bytes = sizeof(T);
+  if constexpr (std::is_same<T, std::string>::value) {
+    auto heap_bytes = size_t{0};
+    auto character_count = size_t{0};
+    for (const auto& value : sample) {
+      heap_bytes += string_heap_bytes(value);
+      character_count += value.size();
+    }
+    profile.value_bytes += (heap_bytes + sample.size() - 1) / sample.size();
+    profile.unencoded_value_bytes = profile.value_bytes;
+    if constexpr (std::is_same<Value, std::string_view>::value) {
+      profile.unencoded_value_bytes = sizeof(uint64_t) + (character_count + sample.size() - 1) / sample.size();
+    }
+
+    // The distinct values of the sample lie further apart than those of the segment and share shorter prefixes, so
+    // front coding them overestimates the size of the dictionary rather than underestimating it
+    auto distinct_values = std::vector<Value>{};
+    distinct_values.reserve(frequencies.size());
+    for (const auto& entry : frequencies) {
+      distinct_values.emplace_back(entry.first);
+    }
+    std::sort(distinct_values.begin(), distinct_values.end());
+    const auto dictionary = FrontCodedDictionary{distinct_values};
+    profile.front_coded_value_bytes =
+        (dictionary.estimate_memory_usage() - sizeof(FrontCodedDictionary) + distinct_values.size() - 1) /
+        distinct_values.size();
+  }
+
+  if constexpr (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+    // The bit width of FrameOfReference offsets is determined by the largest range of a block, so a sample does not
+    // suffice. One pass over the values is still much cheaper than encoding them.
+    using UnsignedT = std::make_unsigned_t<T>;
+    auto max_range = UnsignedT{0};
+    auto max_delta = UnsignedT{0};
+    profile.is_sorted = true;
+    constexpr auto block_size = FrameOfReferenceSegment<T>::block_size;
+    for (size_t block_begin = 0; block_begin < profile.row_count; block_begin += block_size) {
+      const auto block_end = std::min(profile.row_count, block_begin + block_size);
+      auto minimum = values[block_begin];
+      auto maximum = values[block_begin];
+      for (auto row = block_begin + 1; row < block_end; ++row) {
+        minimum = std::min(minimum, values[row]);
+        maximum = std::max(maximum, values[row]);
+        if (values[row] < values[row - 1]) profile.is_sorted = false;
+        max_delta = std::max(max_delta, static_cast<UnsignedT>(static_cast<UnsignedT>(values[row]) -
+                                                               static_cast<UnsignedT>(values[row - 1])));
+      }
+      if (block_begin > 0 && values[block_begin] < values[block_begin - 1]) profile.is_sorted = false;
+      max_range = std::max(max_range, static_cast<UnsignedT>(static_cast<UnsignedT>(maximum) -
+                                                             static_cast<UnsignedT>(minimum)));
+    }
+    profile.frame_of_reference_bit_width = BitPackedVector::required_bit_width(max_range);
+    profile.delta_bit_width = BitPackedVector::required_bit_width(max_delta);
+  }
+
+  if constexpr (std::is_floating_point<T>::value) {
+    // XOR compression depends on the bits of neighbouring values, which is hard to model, so the sample is encoded
+    const auto sample_size = sample.size();
+    const auto encoded_sample = GorillaSegment<T>{std::make_shared<ValueSegment<T>>(std::move(sample))};
+    profile.gorilla_bits_per_value =
+        static_cast<double>(encoded_sample.compressed_bit_count()) / static_cast<double>(sample_size);
+  }
+
+  return profile;
+}
+
+// Bytes of a bit-packed vector
+size_t bit_packed_bytes(const size_t size, const uint8_t bit_width) { return (size * bit_width + 63) / 64 * 8; }
+
+// Bytes of the attribute vector of a dictionary segment
+size_t attribute_vector_bytes(const SegmentProfile& profile, const VectorCompressionType vector_compression) {
+  if (vector_compression == VectorCompressionType::BitPacked) {
+    const auto max_value_id = profile.distinct_count == 0 ? size_t{0} : profile.distinct_count - 1;
+    return bit_packed_bytes(profile.row_count, BitPackedVector::required_bit_width(max_value_id));
+  }
+  // See DictionarySegment for how the width of the value ids is chosen
+  auto value_id_bytes = size_t{4};
+  if (profile.distinct_count <= std::numeric_limits<uint8_t>::max()) {
+    value_id_bytes = 1;
+  } else if (profile.distinct_count <= std::numeric_limits<uint16_t>::max()) {
+    value_id_bytes = 2;
+  }
+  return profile.row_count * value_id_bytes;
+}
+
+}  // namespace
+
+SegmentProfile profile_segment(const std::string& type, const std::shared_ptr<const BaseSegment>& segment) {
+  auto profile = std::optional<SegmentProfile>{};
+  resolve_data_type(type, [&](auto data_type) {
+    using DataType = typename decltype(data_type)::type;
+    if constexpr (std::is_same<DataType, std::string>::value) {
+      if (const auto string_segment = std::dynamic_pointer_cast<const ContiguousStringSegment>(segment)) {
+        profile = profile_values<DataType>(string_segment->strings(), string_segment->size());
+        return;
+      }
+    }
+
+    const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<DataType>>(segment);
+    Assert(static_cast<bool>(value_segment), "Only unencoded segments can be profiled");
+    profile = profile_values<DataType>(value_segment->values(), value_segment->size());
+  });
+  return *profile;
+}
+
+std::optional<size_t> estimate_encoded_bytes(const std::string& type, const SegmentProfile& profile,
+                                             const EncodingType encoding_type,
+                                             const VectorCompressionType vector_compression) {
+  const auto is_integer = type == "int" || type == "long";
+  const auto is_floating_point = type == "float" || type == "double";
+
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return profile.row_count * profile.unencoded_value_bytes;
+    case EncodingType::Dictionary: {
+      auto dictionary_bytes = profile.distinct_count * profile.value_bytes;
+      // Large numeric dictionaries get a search index with a copy of the values and their positions
+      if (type != "string" && profile.distinct_count >= DictionarySegment<int32_t>::search_index_min_size) {
+        dictionary_bytes += profile.distinct_count * (profile.value_bytes + sizeof(ValueID));
+      }
+      return dictionary_bytes + attribute_vector_bytes(profile, vector_compression);
+    }
+    case EncodingType::FrontCodedDictionary:
+      if (type != "string") return std::nullopt;
+      return profile.distinct_count * profile.front_coded_value_bytes +
+             attribute_vector_bytes(profile, vector_compression);
+    case EncodingType::RunLength:
+      return profile.run_count * (profile.value_bytes + sizeof(ChunkOffset));
+    case EncodingType::FrameOfReference:
+    case EncodingType::FrameOfReferenceDelta: {
+      const auto is_delta = encoding_type == EncodingType::FrameOfReferenceDelta;
+      if (!is_integer || (is_delta && !profile.is_sorted)) return std::nullopt;
+      // int and long have the same block size
+      constexpr auto block_size = FrameOfReferenceSegment<int32_t>::block_size;
+      const auto block_count = (profile.row_count + block_size - 1) / block_size;
+      const auto bit_width = is_delta ? profile.delta_bit_width : profile.frame_of_reference_bit_width;
+      return block_count * profile.value_bytes + bit_packed_bytes(profile.row_count, bit_width);
+    }
+    case EncodingType::Gorilla: {
+      if (!is_floating_point) return std::nullopt;
+      constexpr auto block_size = GorillaSegment<double>::block_size;
+      const auto block_count = (profile.row_count + block_size - 1) / block_size;
+      return static_cast<size_t>(std::ceil(profile.gorilla_bits_per_value * static_cast<double>(profile.row_count) /
+                                           8.0)) +
+             block_count * sizeof(size_t);
+    }
+    case EncodingType::Automatic:
+      return std::nullopt;
+  }
+  Fail("Unknown encoding type");
+  return std::nullopt;
+}
+
+SegmentEncodingSpec advise_segment_encoding(const std::string& type, const std::shared_ptr<const BaseSegment>& segment,
+                                            SegmentEncodingSpec spec) {
+  const auto profile = profile_segment(type, segment);
+
+  auto best_bytes = std::numeric_limits<double>::max();
+  for (const auto encoding_type :
+       {EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::FrontCodedDictionary, EncodingType::RunLength,
+        EncodingType::FrameOfReference, EncodingType::FrameOfReferenceDelta, EncodingType::Gorilla}) {
+    const auto bytes = estimate_encoded_bytes(type, profile, encoding_type, spec.vector_compression);
+    if (!bytes || static_cast<double>(*bytes) >= best_bytes * preference_margin) continue;
+    best_bytes = static_cast<double>(*bytes);
+    spec.encoding_type = encoding_type;
+  }
+  return spec;
+}
+
+}  // namespace opossum
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+
+// Characteristics of a ValueSegment that determine how large it is in each encoding. Distinct values, runs, and the
+// compressibility of floating point values are estimated from a sample of the rows. The properties that decide
+// whether FrameOfReference encodings are possible at all, i.e., sortedness and bit widths, are exact.
+struct SegmentProfile {
+  size_t row_count = 0;
+  size_t sampled_row_count = 0;
+  size_t distinct_count = 0;
+  size_t run_count = 0;
+  // average bytes per value in encodings that store strings as std::string, including the characters on the heap
+  size_t value_bytes = 0;
+  // average bytes per row of the segment as it is, which differs from value_bytes for ContiguousStringSegments
+  size_t unencoded_value_bytes = 0;
+  // only determined for string columns: average bytes per entry of a FrontCodedDictionary
+  size_t front_coded_value_bytes = 0;
+  // only determined for int and long columns
+  bool is_sorted = false;
+  uint8_t frame_of_reference_bit_width = 0;
+  uint8_t delta_bit_width = 0;
+  // only determined for float and double columns
+  double gorilla_bits_per_value = 0.0;
+};
+
+// The encoding that was chosen for a segment, with the estimated bytes of the segment before and after the encoding
+struct EncodingDecision {
+  ChunkID chunk_id;
+  ColumnID column_id;
+  std::string encoding;
+  // true if the encoding was given for the column (see Table::set_column_encoding) instead of the chunk
+  bool is_column_override;
+  size_t unencoded_bytes;
+  size_t encoded_bytes;
+
+  double compression_ratio() const {
+    return encoded_bytes == 0 ? 0.0 : static_cast<double>(unencoded_bytes) / static_cast<double>(encoded_bytes);
+  }
+};
+
+// Number of sampled runs of consecutive rows and their length. Consecutive rows keep the runs and the neighbourhood
+// of values that RunLength and Gorilla encodings exploit.
+constexpr size_t encoding_sample_run_count = 16;
+constexpr size_t encoding_sample_run_length = 64;
+
+// Profiles a ValueSegment of the given data type or a ContiguousStringSegment
+SegmentProfile profile_segment(const std::string& type, const std::shared_ptr<const BaseSegment>& segment);
+
+// Estimates the bytes that a segment with the given profile occupies in an encoding, or returns nullopt if the
+// encoding does not support the data type or the values. The vector compression is only used by the dictionary
+// encodings.
+std::optional<size_t> estimate_encoded_bytes(const std::string& type, const SegmentProfile& profile,
+                                             const EncodingType encoding_type,
+                                             const VectorCompressionType vector_compression);
+
+// Returns spec with the encoding type that makes the segment smallest. If several encodings are about as small, the
+// one that is cheapest to scan is preferred, in the order Unencoded, Dictionary, FrontCodedDictionary, RunLength,
+// FrameOfReference, FrameOfReferenceDelta, and Gorilla. An encoding thus has to save at least a tenth of the memory
+// to be chosen.
+SegmentEncodingSpec advise_segment_encoding(const std::string& type, const std::shared_ptr<const BaseSegment>& segment,
+                                            SegmentEncodingSpec spec = {});
+
+}  // namespace opossum
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace opossum {
+
+// Determines which segment type Table::compress_chunk() creates from a ValueSegment.
+// FrameOfReference and FrameOfReferenceDelta are only available for int and long columns, the delta variant also
+// requires the values to be non-decreasing. Gorilla is only available for float and double columns,
+// FrontCodedDictionary only for string columns.
+// Automatic chooses one of the others for each segment, the one that makes it smallest (see encoding_advisor.hpp).
+enum class EncodingType {
+  Unencoded,
+  Dictionary,
+  FrontCodedDictionary,
+  RunLength,
+  FrameOfReference,
+  FrameOfReferenceDelta,
+  Gorilla,
+  Automatic
+};
+
+// Determines how the attribute vector of a dictionary segment stores its value ids: FixedSizeByteAligned uses the
+// smallest of 8, 16, or 32 bit per value id, BitPacked uses exactly as many bits as the largest value id needs.
+enum class VectorCompressionType { FixedSizeByteAligned, BitPacked };
+
+// Describes how a segment is encoded. vector_compression is ignored by encodings that do not use it.
+// If bloom_filter_bits_per_value is not 0, the statistics of the segment get a Bloom filter of that size, which lets
+// scans skip segments for equality predicates. Ten bits per value give a false positive rate of about one percent.
+struct SegmentEncodingSpec {
+  EncodingType encoding_type = EncodingType::Dictionary;
+  VectorCompressionType vector_compression = VectorCompressionType::FixedSizeByteAligned;
+  uint32_t bloom_filter_bits_per_value = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace opossum {
+
+// A search index over sorted values that stores them in Eytzinger order, i.e., in the order of a breadth-first
+// traversal of the implicit binary search tree: the children of the value at index k are at 2k and 2k + 1, the root is
+// at 1. A binary search on the sorted values touches a new cache line with nearly every step once the range is larger
+// than a cache line, and these accesses depend on each other. Here, the top levels of the tree that every search
+// visits share a few cache lines that stay cached, and the descendants four levels below a node are adjacent, so they
+// are prefetched while the search goes on. The search loop has no branch that depends on the comparison.
+// See Khuong and Morin, "Array Layouts for Comparison-Based Searching", 2017.
+template <typename T>
+class EytzingerIndex {
+ public:
+  explicit EytzingerIndex(const std::vector<T>& sorted_values)
+      : _values(sorted_values.size() + 1), _positions(sorted_values.size() + 1) {
+    auto sorted_index = size_t{0};
+    _build(sorted_values, sorted_index, 1);
+  }
+
+  // returns the index of the first value >= value in the sorted values, or their number if all are smaller
+  size_t lower_bound(const T& value) const {
+    return _search([&](const T& node_value) { return node_value < value; });
+  }
+
+  // returns the index of the first value > value in the sorted values, or their number if all are smaller or equal
+  size_t upper_bound(const T& value) const {
+    return _search([&](const T& node_value) { return node_value <= value; });
+  }
+
+  // returns the number of values
+  size_t size() const { return _values.size() - 1; }
+
+  // return an estimate of the bytes used
+  size_t estimate_memory_usage() const {
+    return sizeof(*this) + _values.capacity() * sizeof(T) + _positions.capacity() * sizeof(uint32_t);
+  }
+
+ protected:
+  // The descendants of node k on the level that is log2(stride) levels below it are stored from stride * k on and fill
+  // a cache line, i.e., four levels below for four byte values and three for eight byte values
+  static constexpr size_t _prefetch_stride = 64 / sizeof(T) < 16 ? 64 / sizeof(T) : 16;
+
+  // Assigns the sorted values to the subtree rooted at node by an in-order traversal
+  void _build(const std::vector<T>& sorted_values, size_t& sorted_index, const size_t node) {
+    if (node >= _values.size()) return;
+    _build(sorted_values, sorted_index, 2 * node);
+    _values[node] = sorted_values[sorted_index];
+    _positions[node] = static_cast<uint32_t>(sorted_index);
+    ++sorted_index;
+    _build(sorted_values, sorted_index, 2 * node + 1);
+  }
+
+  // returns the sorted index of the first value for which is_before() is false
+  template <typename IsBefore>
+  size_t _search(const IsBefore& is_before) const {
+    auto node = size_t{1};
+    while (node < _values.size()) {
+      __builtin_prefetch(_values.data() + node * _prefetch_stride);
+      node = 2 * node + (is_before(_values[node]) ? 1 : 0);
+    }
+    // The search went right after the last node that was not before the value, so the trailing ones are removed. If it
+    // only went right, no value is left.
+    node >>= __builtin_ffsll(static_cast<int64_t>(~node));
+    return node == 0 ? size() : _positions[node];
+  }
+
+  // index 0 is not used
+  std::vector<T> _values;
+  std::vector<uint32_t> _positions;
+};
+
+}  // namespace opossum
@@ -1,34 +1,57 @@
 #pragma once
 
-#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base_attribute_vector.hpp"
+#include "utils/assert.hpp"
 
 namespace opossum {
 
 template <class T>
 class FittedAttributeVector : public BaseAttributeVector {
  public:
-  explicit FittedAttributeVector(const size_t size) : _values(std::make_shared<std::vector<T>>(size)) {}
+  explicit FittedAttributeVector(const size_t size)
+      : _values(std::make_shared<std::vector<T>>(size)), _data(_values->data()), _size(size) {}
+
+  // Wraps codes that are stored elsewhere, e.g., in a memory-mapped snapshot, without copying them. owner keeps the
+  // codes alive. Such an attribute vector is read-only.
+  FittedAttributeVector(const T* codes, const size_t size, std::shared_ptr<const void> owner)
+      : _data(codes), _size(size), _owner(std::move(owner)) {}
+
   virtual ~FittedAttributeVector() = default;
 
   // returns the value id at a given position
-  ValueID get(const size_t i) const override { return ValueID{(*_values)[i]}; }
+  ValueID get(const size_t i) const override { return ValueID{_data[i]}; }
 
   // sets the value id at a given position
-  void set(const size_t i, const ValueID value_id) override { (*_values)[i] = value_id; }
+  void set(const size_t i, const ValueID value_id) override {
+    DebugAssert(static_cast<bool>(_values), "Wrapped attribute vectors are read-only");
+    (*_values)[i] = value_id;
+  }
 
   // returns the number of values
-  size_t size() const override { return _values->size(); }
+  size_t size() const override { return _size; }
+
+  // returns the underlying codes, e.g., for scans that operate on them directly instead of calling get() per row
+  const T* data() const { return _data; }
 
   // returns the width of biggest value id in bytes
   AttributeVectorWidth width() const override {
-    return static_cast<AttributeVectorWidth>(sizeof(*std::max(_values->cbegin(), _values->cend())));
+    return static_cast<AttributeVectorWidth>(sizeof(T));
+  }
+
+  // returns an estimate of the bytes used, wrapped codes are counted although they are not owned
+  size_t estimate_memory_usage() const override {
+    return sizeof(*this) + (_values ? _values->capacity() : _size) * sizeof(T);
   }
 
  protected:
+  // nullptr if the codes are owned by _owner
   std::shared_ptr<std::vector<T>> _values;
+  const T* _data;
+  size_t _size;
+  std::shared_ptr<const void> _owner;
 };
 }  // namespace opossum
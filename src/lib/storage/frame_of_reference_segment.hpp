@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "bit_packed_vector.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+/**
+ * FrameOfReferenceSegment stores integers as bit-packed, unsigned offsets from the minimum of their block. Timestamps
+ * or surrogate keys, which have many distinct but close values, thereby need only as many bits as the largest
+ * difference within a block.
+ *
+ * The delta variant stores the difference to the preceding value instead (and the first value of each block as its
+ * minimum). It requires the values to be non-decreasing, which makes the offsets of, e.g., auto-incremented keys tiny.
+ */
+template <typename T>
+class FrameOfReferenceSegment : public BaseSegment {
+  static_assert(std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value,
+                "FrameOfReferenceSegment only supports int and long");
+
+ public:
+  using UnsignedT = std::make_unsigned_t<T>;
+
+  // number of rows that share a minimum
+  static constexpr ChunkOffset block_size = 1024;
+
+  /**
+   * Creates a FrameOfReference segment from a given value segment.
+   */
+  explicit FrameOfReferenceSegment(const std::shared_ptr<BaseSegment>& base_segment, const bool is_delta = false)
+      : _block_minimums(std::make_shared<std::vector<T>>()), _is_delta(is_delta) {
+    const auto& value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    DebugAssert(static_cast<bool>(value_segment), "FrameOfReference segments can only be created from value segments");
+
+    const auto& values = value_segment->values();
+    if (is_delta) {
+      Assert(std::is_sorted(values.cbegin(), values.cend()), "Delta encoding requires non-decreasing values");
+    }
+
+    for (size_t block_begin = 0; block_begin < values.size(); block_begin += block_size) {
+      const auto block_end = std::min(values.size(), block_begin + block_size);
+      _block_minimums->emplace_back(*std::min_element(values.cbegin() + block_begin, values.cbegin() + block_end));
+    }
+
+    // Compute the offsets first, as the largest of them determines the bit width
+    auto offsets = std::vector<UnsignedT>(values.size());
+    for (size_t index = 0; index < values.size(); ++index) {
+      const auto reference = _is_delta && index % block_size != 0 ? values[index - 1] : minimum_of(index / block_size);
+      offsets[index] = static_cast<UnsignedT>(values[index]) - static_cast<UnsignedT>(reference);
+    }
+
+    const auto max_offset = offsets.empty() ? UnsignedT{0} : *std::max_element(offsets.cbegin(), offsets.cend());
+    _offsets = std::make_shared<BitPackedVector>(offsets.size(), BitPackedVector::required_bit_width(max_offset));
+    for (size_t index = 0; index < offsets.size(); ++index) {
+      _offsets->set(index, offsets[index]);
+    }
+  }
+
+  /**
+   * Creates a FrameOfReference segment from blocks that were encoded before, e.g., when loading a snapshot.
+   */
+  FrameOfReferenceSegment(std::shared_ptr<std::vector<T>> block_minimums, std::shared_ptr<BitPackedVector> offsets,
+                          const bool is_delta)
+      : _block_minimums(std::move(block_minimums)), _offsets(std::move(offsets)), _is_delta(is_delta) {
+    DebugAssert(_block_minimums->size() == (_offsets->size() + block_size - 1) / block_size, "Wrong number of blocks");
+  }
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override { return get(i); }
+
+  // return the value at a certain position. For delta segments, this sums up the offsets of the block up to i.
+  const T get(const size_t i) const {
+    DebugAssert(i < size(), "Offset out of range");
+    const auto block_index = i / block_size;
+    auto value = static_cast<UnsignedT>(minimum_of(block_index));
+
+    if (!_is_delta) return static_cast<T>(value + _offsets->get(i));
+
+    for (auto index = block_index * block_size + 1; index <= i; ++index) {
+      value += _offsets->get(index);
+    }
+    return static_cast<T>(value);
+  }
+
+  // Writes the values of a block to out, which has to hold at least block_size values
+  void decode_block(const size_t block_index, T* out) const {
+    const auto block_begin = block_index * block_size;
+    const auto count = std::min(size() - block_begin, size_t{block_size});
+
+    auto decoded = reinterpret_cast<UnsignedT*>(out);
+    _offsets->decode(block_begin, count, decoded);
+
+    if (_is_delta) {
+      // The offset of the first row is zero, so this computes the prefix sums starting at the block's first value
+      auto value = static_cast<UnsignedT>(minimum_of(block_index));
+      for (size_t index = 0; index < count; ++index) {
+        value += decoded[index];
+        decoded[index] = value;
+      }
+    } else {
+      const auto minimum = static_cast<UnsignedT>(minimum_of(block_index));
+      for (size_t index = 0; index < count; ++index) {
+        decoded[index] += minimum;
+      }
+    }
+  }
+
+  // frame of reference segments are immutable
+  void append(const AllTypeVariant&) override { throw std::runtime_error("FrameOfReference segments are immutable"); }
+
+  // returns the minimum (for delta segments: the first value) of every block
+  std::shared_ptr<const std::vector<T>> block_minimums() const { return _block_minimums; }
+
+  // returns the minimum (for delta segments: the first value) of a block
+  T minimum_of(const size_t block_index) const { return (*_block_minimums)[block_index]; }
+
+  // returns the bit-packed offsets
+  std::shared_ptr<const BitPackedVector> offsets() const { return _offsets; }
+
+  // returns true if the offsets are deltas to the preceding value
+  bool is_delta() const { return _is_delta; }
+
+  // return the number of blocks
+  size_t block_count() const { return _block_minimums->size(); }
+
+  // return the number of entries
+  size_t size() const override { return _offsets->size(); }
+
+  // return an estimate of the bytes used by the blocks
+  size_t estimate_memory_usage() const override {
+    return sizeof(*this) + estimate_vector_memory_usage(*_block_minimums) + _offsets->estimate_memory_usage();
+  }
+
+ protected:
+  std::shared_ptr<std::vector<T>> _block_minimums;
+  std::shared_ptr<BitPackedVector> _offsets;
+  bool _is_delta;
+};
+
+}  // namespace opossum
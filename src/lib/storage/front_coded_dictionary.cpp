@@ -0,0 +1,168 @@
+#include "front_coded_dictionary.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Lengths are stored in seven bits per byte, the highest bit marks that another byte follows. Most prefixes and
+// suffixes are shorter than 128 characters and take a single byte.
+void write_length(std::vector<char>& data, size_t length) {
+  while (length >= 0x80) {
+    data.push_back(static_cast<char>((length & 0x7F) | 0x80));
+    length >>= 7;
+  }
+  data.push_back(static_cast<char>(length));
+}
+
+size_t read_length(const char*& position) {
+  auto length = size_t{0};
+  for (auto shift = 0u;; shift += 7) {
+    const auto byte = static_cast<uint8_t>(*position++);
+    length |= static_cast<size_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) return length;
+  }
+}
+
+// Decodes the strings of a block one after another
+class BlockReader {
+ public:
+  explicit BlockReader(const char* block) : _position(block) {
+    const auto length = read_length(_position);
+    _string.assign(_position, length);
+    _position += length;
+  }
+
+  // decodes the next string of the block, which must exist
+  void next() {
+    const auto prefix_length = read_length(_position);
+    const auto suffix_length = read_length(_position);
+    _string.resize(prefix_length);
+    _string.append(_position, suffix_length);
+    _position += suffix_length;
+  }
+
+  const std::string& string() const { return _string; }
+
+ protected:
+  const char* _position;
+  std::string _string;
+};
+
+}  // namespace
+
+FrontCodedDictionary::FrontCodedDictionary(const char* data, const size_t data_size, const uint64_t* block_offsets,
+                                           const size_t size, std::shared_ptr<const void> owner)
+    : _data(data), _data_size(data_size), _block_offsets(block_offsets), _size(size), _owner(std::move(owner)) {}
+
+std::string FrontCodedDictionary::get(const size_t index) const {
+  DebugAssert(index < _size, "Index out of range");
+  auto reader = BlockReader{_data + _block_offsets[index / block_size]};
+  for (size_t position = 0; position < index % block_size; ++position) {
+    reader.next();
+  }
+  return reader.string();
+}
+
+void FrontCodedDictionary::decode_block(const size_t block_index, std::vector<std::string>& strings) const {
+  DebugAssert(block_index < block_count(), "Block index out of range");
+  strings.resize(std::min(block_size, _size - block_index * block_size));
+  auto position = _data + _block_offsets[block_index];
+  const auto length = read_length(position);
+  strings[0].assign(position, length);
+  position += length;
+  for (size_t index = 1; index < strings.size(); ++index) {
+    const auto prefix_length = read_length(position);
+    const auto suffix_length = read_length(position);
+    strings[index].assign(strings[index - 1], 0, prefix_length);
+    strings[index].append(position, suffix_length);
+    position += suffix_length;
+  }
+}
+
+size_t FrontCodedDictionary::lower_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view string) { return string < value; });
+}
+
+size_t FrontCodedDictionary::upper_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view string) { return string <= value; });
+}
+
+size_t FrontCodedDictionary::size() const { return _size; }
+
+size_t FrontCodedDictionary::estimate_memory_usage() const {
+  if (!_owner) {
+    return sizeof(*this) + _owned_data.capacity() + _owned_block_offsets.capacity() * sizeof(uint64_t);
+  }
+  return sizeof(*this) + _data_size + block_count() * sizeof(uint64_t);
+}
+
+const char* FrontCodedDictionary::data() const { return _data; }
+
+size_t FrontCodedDictionary::data_size() const { return _data_size; }
+
+const uint64_t* FrontCodedDictionary::block_offsets() const { return _block_offsets; }
+
+size_t FrontCodedDictionary::block_count() const { return (_size + block_size - 1) / block_size; }
+
+void FrontCodedDictionary::_append(const std::string_view string, const std::string_view previous) {
+  DebugAssert(_size == 0 || previous < string, "Strings have to be sorted and distinct");
+  if (_size % block_size == 0) {
+    _owned_block_offsets.emplace_back(_owned_data.size());
+    write_length(_owned_data, string.size());
+    _owned_data.insert(_owned_data.end(), string.cbegin(), string.cend());
+  } else {
+    const auto prefix_length = static_cast<size_t>(
+        std::mismatch(string.cbegin(), string.cend(), previous.cbegin(), previous.cend()).first - string.cbegin());
+    write_length(_owned_data, prefix_length);
+    write_length(_owned_data, string.size() - prefix_length);
+    _owned_data.insert(_owned_data.end(), string.cbegin() + prefix_length, string.cend());
+  }
+  ++_size;
+}
+
+void FrontCodedDictionary::_finish() {
+  _owned_data.shrink_to_fit();
+  _owned_block_offsets.shrink_to_fit();
+  _data = _owned_data.data();
+  _data_size = _owned_data.size();
+  _block_offsets = _owned_block_offsets.data();
+}
+
+template <typename IsBefore>
+size_t FrontCodedDictionary::_partition_point(const IsBefore& is_before) const {
+  // Find the first block whose first string is not before the value. The first strings are read in place.
+  auto low = size_t{0};
+  auto high = block_count();
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    auto position = _data + _block_offsets[middle];
+    const auto length = read_length(position);
+    if (is_before(std::string_view{position, length})) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0) return 0;
+
+  // The result is in the preceding block, or it is the first string of the found one
+  const auto block = low - 1;
+  const auto end = std::min(_size, (block + 1) * block_size);
+  auto reader = BlockReader{_data + _block_offsets[block]};
+  for (auto index = block * block_size + 1; index < end; ++index) {
+    reader.next();
+    if (!is_before(reader.string())) return index;
+  }
+  return end;
+}
+
+}  // namespace opossum
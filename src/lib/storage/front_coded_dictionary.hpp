@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A sorted dictionary of distinct strings that stores each string as the length of the prefix it shares with its
+// predecessor and the remaining suffix ("front coding", see Brisaboa et al., "Compressed String Dictionaries", 2011).
+// Sorted URLs or names share long prefixes, so the suffixes are much smaller than the strings, and all of them are
+// stored in a single buffer instead of one allocation per string.
+//
+// The strings are grouped into blocks of block_size strings. The first string of a block is stored completely, so
+// every block can be decoded on its own, and the offsets of the blocks form a sampled search index: a lookup binary
+// searches the first strings of the blocks and then decodes a single block. The order of the strings is kept, so
+// lower_bound() and upper_bound() answer range predicates with indices just like std::lower_bound on a vector.
+//
+// The dictionary points into its own buffers, so it cannot be copied. Moving it keeps the buffers.
+class FrontCodedDictionary : private Noncopyable {
+ public:
+  static constexpr size_t block_size = 16;
+
+  // encodes the strings, which have to be sorted and distinct. Strings holds std::strings or std::string_views.
+  template <typename Strings>
+  explicit FrontCodedDictionary(const Strings& strings) {
+    auto previous = std::string_view{};
+    for (const auto& string : strings) {
+      _append(string, previous);
+      previous = string;
+    }
+    _finish();
+  }
+
+  // Wraps a dictionary that is stored elsewhere, e.g., in a memory-mapped snapshot, without copying it. owner keeps
+  // it alive.
+  FrontCodedDictionary(const char* data, const size_t data_size, const uint64_t* block_offsets, const size_t size,
+                       std::shared_ptr<const void> owner);
+
+  // returns the string at the given index
+  std::string get(const size_t index) const;
+
+  // Decodes the strings of a block into strings, which holds block_size strings afterwards, or fewer for the last
+  // block. The memory of the strings is reused, so that decoding one block after another does not allocate.
+  void decode_block(const size_t block_index, std::vector<std::string>& strings) const;
+
+  // returns the index of the first string >= value, or size() if all strings are smaller
+  size_t lower_bound(const std::string_view value) const;
+
+  // returns the index of the first string > value, or size() if all strings are smaller or equal
+  size_t upper_bound(const std::string_view value) const;
+
+  // returns the number of strings
+  size_t size() const;
+
+  // return an estimate of the bytes used, wrapped dictionaries are counted although they are not owned
+  size_t estimate_memory_usage() const;
+
+  // returns the encoded blocks and the offset of each block in them
+  const char* data() const;
+  size_t data_size() const;
+  const uint64_t* block_offsets() const;
+  size_t block_count() const;
+
+ protected:
+  // appends a string to the last block, or starts a new block with it
+  void _append(const std::string_view string, const std::string_view previous);
+
+  // sets the pointers to the owned buffers once all strings are appended
+  void _finish();
+
+  // returns the index of the first string for which is_before() is false
+  template <typename IsBefore>
+  size_t _partition_point(const IsBefore& is_before) const;
+
+  // empty if the dictionary is owned by _owner
+  std::vector<char> _owned_data;
+  std::vector<uint64_t> _owned_block_offsets;
+
+  const char* _data = nullptr;
+  size_t _data_size = 0;
+  const uint64_t* _block_offsets = nullptr;
+  size_t _size = 0;
+  std::shared_ptr<const void> _owner;
+};
+
+}  // namespace opossum
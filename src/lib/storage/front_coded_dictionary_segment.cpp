@@ -0,0 +1,87 @@
+#include "front_coded_dictionary_segment.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order) - unknown to the linter
+#include <utility>
+#include <vector>
+
+#include "contiguous_string_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+FrontCodedDictionarySegment::FrontCodedDictionarySegment(const std::shared_ptr<BaseSegment>& base_segment,
+                                                         const VectorCompressionType vector_compression) {
+  // The value ids are those of a DictionarySegment, but the distinct strings are front coded right away instead of
+  // being copied into a std::vector<std::string> first
+  const auto encode = [&](const auto& values) {
+    _attribute_vector = DictionarySegment<std::string>::encode_value_ids(
+        values, vector_compression, [&](const std::vector<std::string_view>& distinct_values) {
+          _dictionary = std::make_shared<FrontCodedDictionary>(distinct_values);
+        });
+  };
+
+  if (const auto string_segment = std::dynamic_pointer_cast<ContiguousStringSegment>(base_segment)) {
+    encode(string_segment->strings());
+    return;
+  }
+  const auto value_segment = std::dynamic_pointer_cast<ValueSegment<std::string>>(base_segment);
+  DebugAssert(static_cast<bool>(value_segment), "Dictionary segments can only be created from value segments");
+  encode(value_segment->values());
+}
+
+FrontCodedDictionarySegment::FrontCodedDictionarySegment(std::shared_ptr<const FrontCodedDictionary> dictionary,
+                                                         std::shared_ptr<const BaseAttributeVector> attribute_vector)
+    : _dictionary(std::move(dictionary)), _attribute_vector(std::move(attribute_vector)) {}
+
+const AllTypeVariant FrontCodedDictionarySegment::operator[](const size_t i) const { return get(i); }
+
+std::string FrontCodedDictionarySegment::get(const size_t i) const {
+  return _dictionary->get(_attribute_vector->get(i));
+}
+
+void FrontCodedDictionarySegment::append(const AllTypeVariant&) {
+  throw std::runtime_error("Dictionary segments are immutable");
+}
+
+std::shared_ptr<const FrontCodedDictionary> FrontCodedDictionarySegment::dictionary() const { return _dictionary; }
+
+std::shared_ptr<const BaseAttributeVector> FrontCodedDictionarySegment::attribute_vector() const {
+  return _attribute_vector;
+}
+
+std::string FrontCodedDictionarySegment::value_by_value_id(ValueID value_id) const {
+  return _dictionary->get(value_id);
+}
+
+ValueID FrontCodedDictionarySegment::lower_bound(const std::string& value) const {
+  const auto index = _dictionary->lower_bound(value);
+  return index == _dictionary->size() ? INVALID_VALUE_ID : ValueID{index};
+}
+
+ValueID FrontCodedDictionarySegment::lower_bound(const AllTypeVariant& value) const {
+  return lower_bound(type_cast<std::string>(value));
+}
+
+ValueID FrontCodedDictionarySegment::upper_bound(const std::string& value) const {
+  const auto index = _dictionary->upper_bound(value);
+  return index == _dictionary->size() ? INVALID_VALUE_ID : ValueID{index};
+}
+
+ValueID FrontCodedDictionarySegment::upper_bound(const AllTypeVariant& value) const {
+  return upper_bound(type_cast<std::string>(value));
+}
+
+size_t FrontCodedDictionarySegment::unique_values_count() const { return _dictionary->size(); }
+
+size_t FrontCodedDictionarySegment::size() const { return _attribute_vector->size(); }
+
+size_t FrontCodedDictionarySegment::estimate_memory_usage() const {
+  return sizeof(*this) + _dictionary->estimate_memory_usage() + _attribute_vector->estimate_memory_usage();
+}
+
+}  // namespace opossum
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "all_type_variant.hpp"
+#include "base_attribute_vector.hpp"
+#include "base_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "encoding_type.hpp"
+#include "front_coded_dictionary.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A dictionary segment for strings whose dictionary is a FrontCodedDictionary instead of a std::vector<std::string>.
+// The value ids are the same as those of a DictionarySegment<std::string>, so scans translate predicates into value
+// id ranges in the same way. Only the lookups of the dictionary have to decode the strings.
+class FrontCodedDictionarySegment : public BaseSegment {
+ public:
+  // Creates the segment from a ValueSegment<std::string> or a ContiguousStringSegment. vector_compression determines
+  // the type of the attribute vector.
+  explicit FrontCodedDictionarySegment(
+      const std::shared_ptr<BaseSegment>& base_segment,
+      const VectorCompressionType vector_compression = VectorCompressionType::FixedSizeByteAligned);
+
+  // Creates the segment from a dictionary and an attribute vector that were encoded before, e.g., when loading a
+  // snapshot
+  FrontCodedDictionarySegment(std::shared_ptr<const FrontCodedDictionary> dictionary,
+                              std::shared_ptr<const BaseAttributeVector> attribute_vector);
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override;
+
+  // return the value at a certain position
+  std::string get(const size_t i) const;
+
+  // dictionary segments are immutable
+  void append(const AllTypeVariant&) override;
+
+  // returns an underlying dictionary
+  std::shared_ptr<const FrontCodedDictionary> dictionary() const;
+
+  // returns an underlying data structure
+  std::shared_ptr<const BaseAttributeVector> attribute_vector() const;
+
+  // return the value represented by a given ValueID
+  std::string value_by_value_id(ValueID value_id) const;
+
+  // returns the first value ID that refers to a value >= the search value
+  // returns INVALID_VALUE_ID if all values are smaller than the search value
+  ValueID lower_bound(const std::string& value) const;
+  ValueID lower_bound(const AllTypeVariant& value) const;
+
+  // returns the first value ID that refers to a value > the search value
+  // returns INVALID_VALUE_ID if all values are smaller than or equal to the search value
+  ValueID upper_bound(const std::string& value) const;
+  ValueID upper_bound(const AllTypeVariant& value) const;
+
+  // return the number of unique_values (dictionary entries)
+  size_t unique_values_count() const;
+
+  // return the number of entries
+  size_t size() const override;
+
+  // return an estimate of the bytes used by the dictionary and the attribute vector
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  std::shared_ptr<const FrontCodedDictionary> _dictionary;
+  std::shared_ptr<const BaseAttributeVector> _attribute_vector;
+};
+
+}  // namespace opossum
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace detail {
+
+// Appends values of 1 to 64 bits to a stream of 64 bit words
+class BitStreamWriter {
+ public:
+  explicit BitStreamWriter(std::vector<uint64_t>& words) : _words(words) {}
+
+  void write(const uint64_t value, const uint32_t bit_count) {
+    const auto shift = _bit_count % 64;
+    if (shift == 0) _words.emplace_back(0);
+    _words.back() |= value << shift;
+    if (shift + bit_count > 64) _words.emplace_back(value >> (64 - shift));
+    _bit_count += bit_count;
+  }
+
+  size_t bit_count() const { return _bit_count; }
+
+ protected:
+  std::vector<uint64_t>& _words;
+  size_t _bit_count = 0;
+};
+
+// Reads values of 1 to 64 bits that were written by a BitStreamWriter, starting at a given bit
+class BitStreamReader {
+ public:
+  BitStreamReader(const std::vector<uint64_t>& words, const size_t position) : _words(words), _position(position) {}
+
+  uint64_t read(const uint32_t bit_count) {
+    const auto word_index = _position / 64;
+    const auto shift = _position % 64;
+    auto value = _words[word_index] >> shift;
+    if (shift + bit_count > 64) value |= _words[word_index + 1] << (64 - shift);
+    _position += bit_count;
+    return bit_count == 64 ? value : value & ((uint64_t{1} << bit_count) - 1);
+  }
+
+ protected:
+  const std::vector<uint64_t>& _words;
+  size_t _position;
+};
+
+}  // namespace detail
+
+/**
+ * GorillaSegment losslessly compresses floating point values by XORing each value with its predecessor, as proposed
+ * in "Gorilla: A Fast, Scalable, In-Memory Time Series Database" (Pelkonen et al., VLDB 2015). Consecutive values of
+ * sensor data or metrics usually share their sign, exponent, and leading mantissa bits, so that the XOR has long runs
+ * of leading and trailing zeros. Only the bits in between are stored:
+ *
+ *   '0'                                     the value equals its predecessor
+ *   '10' + bits                             the meaningful bits fit into the window of the last '11' entry
+ *   '11' + leading zeros + length + bits    opens a new window, both fields use 5 (float) or 6 (double) bits
+ *
+ * The first value of each block is stored uncompressed, so that blocks can be decoded independently.
+ */
+template <typename T>
+class GorillaSegment : public BaseSegment {
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                "GorillaSegment only supports float and double");
+
+ public:
+  // the unsigned integer type with the same size as T
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+  // number of rows that are decoded together
+  static constexpr ChunkOffset block_size = 1024;
+
+  /**
+   * Creates a Gorilla segment from a given value segment.
+   */
+  explicit GorillaSegment(const std::shared_ptr<BaseSegment>& base_segment)
+      : _words(std::make_shared<std::vector<uint64_t>>()),
+        _block_bit_offsets(std::make_shared<std::vector<size_t>>()) {
+    const auto& value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    DebugAssert(static_cast<bool>(value_segment), "Gorilla segments can only be created from value segments");
+
+    const auto& values = value_segment->values();
+    _size = values.size();
+
+    auto writer = detail::BitStreamWriter(*_words);
+    Bits previous = 0;
+    uint32_t window_leading_zeros = 0;
+    uint32_t window_trailing_zeros = 0;
+    auto has_window = false;
+
+    for (size_t index = 0; index < values.size(); ++index) {
+      const auto bits = _to_bits(values[index]);
+
+      if (index % block_size == 0) {
+        _block_bit_offsets->emplace_back(writer.bit_count());
+        writer.write(bits, value_bit_count);
+        previous = bits;
+        has_window = false;
+        continue;
+      }
+
+      const auto xored = static_cast<Bits>(bits ^ previous);
+      previous = bits;
+
+      if (xored == 0) {
+        writer.write(0, 1);
+        continue;
+      }
+
+      const auto leading_zeros = _count_leading_zeros(xored);
+      const auto trailing_zeros = static_cast<uint32_t>(__builtin_ctzll(xored));
+      writer.write(1, 1);
+
+      if (has_window && leading_zeros >= window_leading_zeros && trailing_zeros >= window_trailing_zeros) {
+        writer.write(0, 1);
+        writer.write(xored >> window_trailing_zeros, value_bit_count - window_leading_zeros - window_trailing_zeros);
+        continue;
+      }
+
+      const auto meaningful_bit_count = value_bit_count - leading_zeros - trailing_zeros;
+      writer.write(1, 1);
+      writer.write(leading_zeros, field_bit_count);
+      writer.write(meaningful_bit_count - 1, field_bit_count);
+      writer.write(xored >> trailing_zeros, meaningful_bit_count);
+
+      has_window = true;
+      window_leading_zeros = leading_zeros;
+      window_trailing_zeros = trailing_zeros;
+    }
+
+    _words->shrink_to_fit();
+    _block_bit_offsets->shrink_to_fit();
+  }
+
+  /**
+   * Creates a Gorilla segment from a bit stream that was encoded before, e.g., when loading a snapshot.
+   */
+  GorillaSegment(std::shared_ptr<std::vector<uint64_t>> words, std::shared_ptr<std::vector<size_t>> block_bit_offsets,
+                 const size_t size)
+      : _words(std::move(words)), _block_bit_offsets(std::move(block_bit_offsets)), _size(size) {
+    DebugAssert(_block_bit_offsets->size() == (size + block_size - 1) / block_size, "Wrong number of blocks");
+  }
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override { return get(i); }
+
+  // return the value at a certain position. This decodes the block up to the position.
+  const T get(const size_t i) const {
+    DebugAssert(i < size(), "Offset out of range");
+    auto values = std::vector<T>(i % block_size + 1);
+    _decode(i / block_size, values.size(), values.data());
+    return values.back();
+  }
+
+  // Writes the values of a block to out, which has to hold at least block_size values
+  void decode_block(const size_t block_index, T* out) const {
+    _decode(block_index, std::min(size_t{block_size}, _size - block_index * block_size), out);
+  }
+
+  // gorilla segments are immutable
+  void append(const AllTypeVariant&) override { throw std::runtime_error("Gorilla segments are immutable"); }
+
+  // return the number of blocks
+  size_t block_count() const { return _block_bit_offsets->size(); }
+
+  // return the number of bits that the compressed values occupy
+  size_t compressed_bit_count() const { return _words->size() * 64; }
+
+  // return the words of the bit stream
+  std::shared_ptr<const std::vector<uint64_t>> words() const { return _words; }
+
+  // return the position of the first bit of every block in the bit stream
+  std::shared_ptr<const std::vector<size_t>> block_bit_offsets() const { return _block_bit_offsets; }
+
+  // return the number of entries
+  size_t size() const override { return _size; }
+
+  // return an estimate of the bytes used by the bit stream
+  size_t estimate_memory_usage() const override {
+    return sizeof(*this) + estimate_vector_memory_usage(*_words) + estimate_vector_memory_usage(*_block_bit_offsets);
+  }
+
+ protected:
+  static constexpr uint32_t value_bit_count = sizeof(T) * 8;
+  // number of bits needed to store the leading zeros (0 to value_bit_count - 1) and the meaningful bit count minus 1
+  static constexpr uint32_t field_bit_count = sizeof(T) == 4 ? 5 : 6;
+
+  static Bits _to_bits(const T value) {
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+  }
+
+  static T _from_bits(const Bits bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+
+  static uint32_t _count_leading_zeros(const Bits bits) {
+    return static_cast<uint32_t>(__builtin_clzll(bits)) - (64 - value_bit_count);
+  }
+
+  // decodes the first count values of a block
+  void _decode(const size_t block_index, const size_t count, T* out) const {
+    auto reader = detail::BitStreamReader(*_words, (*_block_bit_offsets)[block_index]);
+    auto bits = static_cast<Bits>(reader.read(value_bit_count));
+    uint32_t window_leading_zeros = 0;
+    uint32_t window_trailing_zeros = 0;
+
+    out[0] = _from_bits(bits);
+    for (size_t index = 1; index < count; ++index) {
+      if (reader.read(1) != 0) {
+        if (reader.read(1) != 0) {
+          window_leading_zeros = static_cast<uint32_t>(reader.read(field_bit_count));
+          const auto meaningful_bit_count = static_cast<uint32_t>(reader.read(field_bit_count)) + 1;
+          window_trailing_zeros = value_bit_count - window_leading_zeros - meaningful_bit_count;
+        }
+        const auto meaningful_bits =
+            reader.read(value_bit_count - window_leading_zeros - window_trailing_zeros) << window_trailing_zeros;
+        bits ^= static_cast<Bits>(meaningful_bits);
+      }
+      out[index] = _from_bits(bits);
+    }
+  }
+
+  std::shared_ptr<std::vector<uint64_t>> _words;
+  std::shared_ptr<std::vector<size_t>> _block_bit_offsets;
+  size_t _size;
+};
+
+}  // namespace opossum
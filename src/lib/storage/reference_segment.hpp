@@ -24,13 +24,26 @@ class ReferenceSegment : public BaseSegment {
   ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
                    const std::shared_ptr<const PosList> pos);
 
+  // creates a reference segment whose positions all lie in one chunk of the referenced table
+  ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
+                   const std::shared_ptr<const SingleChunkPosList> pos);
+
   const AllTypeVariant operator[](const size_t i) const override;
 
   void append(const AllTypeVariant&) override { throw std::logic_error("ReferenceSegment is immutable"); };
 
   size_t size() const override;
 
+  // returns an estimate of the bytes used by the position list, which may be shared with other segments. The
+  // referenced values are not included.
+  size_t estimate_memory_usage() const override;
+
+  // returns the positions as RowIDs, or nullptr if the segment was created with a SingleChunkPosList
   const std::shared_ptr<const PosList> pos_list() const;
+
+  // returns the positions if they lie in a single chunk, nullptr otherwise
+  const std::shared_ptr<const SingleChunkPosList> single_chunk_pos_list() const;
+
   const std::shared_ptr<const Table> referenced_table() const;
 
   ColumnID referenced_column_id() const;
@@ -38,7 +51,9 @@ class ReferenceSegment : public BaseSegment {
  protected:
   const std::shared_ptr<const Table> _table;
   const ColumnID _column_id;
+  // exactly one of them is set
   const std::shared_ptr<const PosList> _pos_list;
+  const std::shared_ptr<const SingleChunkPosList> _single_chunk_pos_list;
 };
 
 }  // namespace opossum
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "contiguous_string_segment.hpp"
+#include "type_cast.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+// RunLengthSegment stores runs of equal consecutive values as a single value and the offset of the run's last row.
+// Sorted or clustered columns thereby need one entry per run instead of one per row.
+template <typename T>
+class RunLengthSegment : public BaseSegment {
+ public:
+  /**
+   * Creates a RunLength segment from a given value segment, or from a ContiguousStringSegment for strings.
+   */
+  explicit RunLengthSegment(const std::shared_ptr<BaseSegment>& base_segment)
+      : _values(std::make_shared<std::vector<T>>()), _end_positions(std::make_shared<std::vector<ChunkOffset>>()) {
+    if constexpr (std::is_same<T, std::string>::value) {
+      if (const auto string_segment = std::dynamic_pointer_cast<ContiguousStringSegment>(base_segment)) {
+        _encode(string_segment->strings());
+        return;
+      }
+    }
+
+    const auto& value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    DebugAssert(static_cast<bool>(value_segment), "RunLength segments can only be created from value segments");
+    _encode(value_segment->values());
+  }
+
+  /**
+   * Creates a RunLength segment from runs that were encoded before, e.g., when loading a snapshot.
+   */
+  RunLengthSegment(std::shared_ptr<std::vector<T>> values, std::shared_ptr<std::vector<ChunkOffset>> end_positions)
+      : _values(std::move(values)), _end_positions(std::move(end_positions)) {
+    DebugAssert(_values->size() == _end_positions->size(), "Every run needs an end position");
+  }
+
+  // return the value at a certain position. If you want to write efficient operators, back off!
+  const AllTypeVariant operator[](const size_t i) const override { return get(i); }
+
+  // return the value at a certain position.
+  const T get(const size_t i) const {
+    DebugAssert(i < size(), "Offset out of range");
+    const auto run = std::lower_bound(_end_positions->cbegin(), _end_positions->cend(), i);
+    return (*_values)[std::distance(_end_positions->cbegin(), run)];
+  }
+
+  // run length segments are immutable
+  void append(const AllTypeVariant&) override { throw std::runtime_error("RunLength segments are immutable"); }
+
+  // returns the value of every run
+  std::shared_ptr<const std::vector<T>> values() const { return _values; }
+
+  // returns the offset of the last row of every run
+  std::shared_ptr<const std::vector<ChunkOffset>> end_positions() const { return _end_positions; }
+
+  // return the number of runs
+  size_t run_count() const { return _values->size(); }
+
+  // return the number of entries
+  size_t size() const override { return _end_positions->empty() ? 0 : _end_positions->back() + 1; }
+
+  // return an estimate of the bytes used by the runs
+  size_t estimate_memory_usage() const override {
+    return sizeof(*this) + estimate_vector_memory_usage(*_values) + estimate_vector_memory_usage(*_end_positions);
+  }
+
+ protected:
+  // Builds the runs from values, which holds the rows as T or, for strings, as std::string_view
+  template <typename Values>
+  void _encode(const Values& values) {
+    for (ChunkOffset chunk_offset = 0; chunk_offset < values.size(); ++chunk_offset) {
+      if (!_values->empty() && _values->back() == values[chunk_offset]) {
+        _end_positions->back() = chunk_offset;
+        continue;
+      }
+      _values->emplace_back(T{values[chunk_offset]});
+      _end_positions->emplace_back(chunk_offset);
+    }
+
+    _values->shrink_to_fit();
+    _end_positions->shrink_to_fit();
+  }
+
+  std::shared_ptr<std::vector<T>> _values;
+  std::shared_ptr<std::vector<ChunkOffset>> _end_positions;
+};
+
+}  // namespace opossum
@@ -0,0 +1,101 @@
+#include "segment_encoding_utils.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "bit_packed_attribute_vector.hpp"
+#include "contiguous_string_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "encoding_advisor.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary_segment.hpp"
+#include "gorilla_segment.hpp"
+#include "reference_segment.hpp"
+#include "resolve_type.hpp"
+#include "run_length_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+std::shared_ptr<BaseSegment> encode_segment(const std::string& type, const std::shared_ptr<BaseSegment>& segment,
+                                            const SegmentEncodingSpec& spec) {
+  switch (spec.encoding_type) {
+    case EncodingType::Unencoded:
+      return segment;
+    case EncodingType::Dictionary:
+      return make_shared_by_data_type<BaseSegment, DictionarySegment>(type, segment, spec.vector_compression);
+    case EncodingType::FrontCodedDictionary:
+      Assert(type == "string", "FrontCodedDictionary encoding is not supported for " + type);
+      return std::make_shared<FrontCodedDictionarySegment>(segment, spec.vector_compression);
+    case EncodingType::RunLength:
+      return make_shared_by_data_type<BaseSegment, RunLengthSegment>(type, segment);
+    case EncodingType::FrameOfReference:
+    case EncodingType::FrameOfReferenceDelta: {
+      // FrameOfReferenceSegment cannot be instantiated for all data types, so make_shared_by_data_type is not an option
+      std::shared_ptr<BaseSegment> encoded_segment;
+      resolve_data_type(type, [&](auto data_type) {
+        using DataType = typename decltype(data_type)::type;
+        if constexpr (std::is_same<DataType, int32_t>::value || std::is_same<DataType, int64_t>::value) {
+          encoded_segment = std::make_shared<FrameOfReferenceSegment<DataType>>(
+              segment, spec.encoding_type == EncodingType::FrameOfReferenceDelta);
+        }
+      });
+      Assert(static_cast<bool>(encoded_segment), "FrameOfReference encoding is not supported for " + type);
+      return encoded_segment;
+    }
+    case EncodingType::Gorilla: {
+      std::shared_ptr<BaseSegment> encoded_segment;
+      resolve_data_type(type, [&](auto data_type) {
+        using DataType = typename decltype(data_type)::type;
+        if constexpr (std::is_floating_point<DataType>::value) {
+          encoded_segment = std::make_shared<GorillaSegment<DataType>>(segment);
+        }
+      });
+      Assert(static_cast<bool>(encoded_segment), "Gorilla encoding is not supported for " + type);
+      return encoded_segment;
+    }
+    case EncodingType::Automatic:
+      return encode_segment(type, segment, advise_segment_encoding(type, segment, spec));
+  }
+  Fail("Unknown encoding type");
+  return nullptr;
+}
+
+std::string segment_encoding_name(const std::string& type, const std::shared_ptr<const BaseSegment>& segment) {
+  if (std::dynamic_pointer_cast<const ReferenceSegment>(segment)) return "Reference";
+
+  auto name = std::string{"Unknown"};
+  resolve_data_type(type, [&](auto data_type) {
+    using DataType = typename decltype(data_type)::type;
+    if (std::dynamic_pointer_cast<const ValueSegment<DataType>>(segment)) {
+      name = "Unencoded";
+    } else if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<DataType>>(segment)) {
+      const auto bit_packed =
+          std::dynamic_pointer_cast<const BitPackedAttributeVector>(dictionary_segment->attribute_vector());
+      name = bit_packed ? "Dictionary (BitPacked)" : "Dictionary";
+    } else if (std::dynamic_pointer_cast<const RunLengthSegment<DataType>>(segment)) {
+      name = "RunLength";
+    }
+
+    if constexpr (std::is_same<DataType, int32_t>::value || std::is_same<DataType, int64_t>::value) {
+      if (const auto for_segment = std::dynamic_pointer_cast<const FrameOfReferenceSegment<DataType>>(segment)) {
+        name = for_segment->is_delta() ? "FrameOfReferenceDelta" : "FrameOfReference";
+      }
+    }
+    if constexpr (std::is_floating_point<DataType>::value) {
+      if (std::dynamic_pointer_cast<const GorillaSegment<DataType>>(segment)) name = "Gorilla";
+    }
+    if constexpr (std::is_same<DataType, std::string>::value) {
+      if (std::dynamic_pointer_cast<const ContiguousStringSegment>(segment)) name = "Unencoded (Contiguous)";
+      if (const auto dictionary_segment = std::dynamic_pointer_cast<const FrontCodedDictionarySegment>(segment)) {
+        const auto bit_packed =
+            std::dynamic_pointer_cast<const BitPackedAttributeVector>(dictionary_segment->attribute_vector());
+        name = bit_packed ? "FrontCodedDictionary (BitPacked)" : "FrontCodedDictionary";
+      }
+    }
+  });
+  return name;
+}
+
+}  // namespace opossum
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "encoding_type.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+
+// Encodes a ValueSegment of the given data type, or a ContiguousStringSegment, as described by spec. Returns the
+// segment itself for EncodingType::Unencoded.
+std::shared_ptr<BaseSegment> encode_segment(const std::string& type, const std::shared_ptr<BaseSegment>& segment,
+                                            const SegmentEncodingSpec& spec);
+
+// Returns the name of the encoding of a segment of the given data type, e.g., "Dictionary" or "Unencoded" for
+// ValueSegments, "Reference" for ReferenceSegments. Dictionary segments with a bit-packed attribute vector are
+// reported as "Dictionary (BitPacked)" or "FrontCodedDictionary (BitPacked)", delta-encoded FrameOfReference segments
+// as "FrameOfReferenceDelta", and ContiguousStringSegments as "Unencoded (Contiguous)".
+std::string segment_encoding_name(const std::string& type, const std::shared_ptr<const BaseSegment>& segment);
+
+}  // namespace opossum
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base_attribute_vector.hpp"
+#include "base_segment.hpp"
+#include "bit_packed_attribute_vector.hpp"
+#include "contiguous_string_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "fitted_attribute_vector.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary.hpp"
+#include "front_coded_dictionary_segment.hpp"
+#include "gorilla_segment.hpp"
+#include "reference_segment.hpp"
+#include "run_length_segment.hpp"
+#include "table.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves the concrete type of a segment whose values are of type T by passing the segment, cast to that type, on to
+ * a generic lambda. The cast happens once per segment, so the lambda can access the values through the non-virtual
+ * methods of the concrete type.
+ *
+ * Example:
+ *
+ *   resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+ *     using SegmentType = std::decay_t<decltype(typed_segment)>;
+ *     if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>) { ... }
+ *   });
+ */
+template <typename T, typename Functor>
+void resolve_segment_type(const BaseSegment& segment, const Functor& func) {
+  if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) return func(*value_segment);
+  if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    return func(*dictionary_segment);
+  }
+  if (const auto run_length_segment = dynamic_cast<const RunLengthSegment<T>*>(&segment)) {
+    return func(*run_length_segment);
+  }
+  if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+    if (const auto frame_of_reference_segment = dynamic_cast<const FrameOfReferenceSegment<T>*>(&segment)) {
+      return func(*frame_of_reference_segment);
+    }
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    if (const auto gorilla_segment = dynamic_cast<const GorillaSegment<T>*>(&segment)) return func(*gorilla_segment);
+  }
+  if constexpr (std::is_same_v<T, std::string>) {
+    if (const auto string_segment = dynamic_cast<const ContiguousStringSegment*>(&segment)) {
+      return func(*string_segment);
+    }
+    if (const auto dictionary_segment = dynamic_cast<const FrontCodedDictionarySegment*>(&segment)) {
+      return func(*dictionary_segment);
+    }
+  }
+  if (const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) return func(*reference_segment);
+  Fail("Unknown segment type");
+}
+
+namespace detail {
+
+// Calls func(value_id) for every value id of the attribute vector in order
+template <typename Functor>
+void iterate_value_ids(const BaseAttributeVector& attribute_vector, const Functor& func) {
+  const auto size = attribute_vector.size();
+  const auto iterate_codes = [&](const auto* codes) {
+    for (size_t offset = 0; offset < size; ++offset) func(ValueID{codes[offset]});
+  };
+  if (const auto codes = dynamic_cast<const FittedAttributeVector<uint8_t>*>(&attribute_vector)) {
+    return iterate_codes(codes->data());
+  }
+  if (const auto codes = dynamic_cast<const FittedAttributeVector<uint16_t>*>(&attribute_vector)) {
+    return iterate_codes(codes->data());
+  }
+  if (const auto codes = dynamic_cast<const FittedAttributeVector<uint32_t>*>(&attribute_vector)) {
+    return iterate_codes(codes->data());
+  }
+  if (const auto bit_packed = dynamic_cast<const BitPackedAttributeVector*>(&attribute_vector)) {
+    // Bit-packed value ids are unpacked a block at a time
+    constexpr auto block_size = size_t{1024};
+    auto value_ids = std::vector<ValueID::base_type>(std::min(size, block_size));
+    for (size_t block_begin = 0; block_begin < size; block_begin += block_size) {
+      const auto count = std::min(block_size, size - block_begin);
+      bit_packed->decode(static_cast<ChunkOffset>(block_begin), count, value_ids.data());
+      for (size_t index = 0; index < count; ++index) func(ValueID{value_ids[index]});
+    }
+    return;
+  }
+  for (size_t offset = 0; offset < size; ++offset) func(attribute_vector.get(offset));
+}
+
+// Decodes the strings of a FrontCodedDictionary a block at a time and keeps the block that was decoded last, so that
+// neighbouring value ids do not decode their block again
+class FrontCodedBlockCache {
+ public:
+  explicit FrontCodedBlockCache(const FrontCodedDictionary& dictionary) : _dictionary(dictionary) {}
+
+  const std::string& get(const ValueID value_id) {
+    const auto block_index = value_id / FrontCodedDictionary::block_size;
+    if (block_index != _block_index) {
+      _dictionary.decode_block(block_index, _strings);
+      _block_index = block_index;
+    }
+    return _strings[value_id % FrontCodedDictionary::block_size];
+  }
+
+ protected:
+  const FrontCodedDictionary& _dictionary;
+  size_t _block_index = std::numeric_limits<size_t>::max();
+  std::vector<std::string> _strings;
+};
+
+// The following functions call func(value) for the values of a segment of the respective type at the chunk offsets
+// chunk_offset_of(index) for index in [begin, end)
+
+template <typename T, typename ChunkOffsetOf, typename Functor>
+void iterate_value_segment_positions(const ValueSegment<T>& segment, const size_t begin, const size_t end,
+                                     const ChunkOffsetOf& chunk_offset_of, const Functor& func) {
+  const auto& values = segment.values();
+  for (auto index = begin; index < end; ++index) func(values[chunk_offset_of(index)]);
+}
+
+template <typename T, typename ChunkOffsetOf, typename Functor>
+void iterate_dictionary_segment_positions(const DictionarySegment<T>& segment, const size_t begin, const size_t end,
+                                          const ChunkOffsetOf& chunk_offset_of, const Functor& func) {
+  const auto& attribute_vector = *segment.attribute_vector();
+  for (auto index = begin; index < end; ++index) {
+    func(segment.value_by_value_id(attribute_vector.get(chunk_offset_of(index))));
+  }
+}
+
+template <typename ChunkOffsetOf, typename Functor>
+void iterate_front_coded_dictionary_segment_positions(const FrontCodedDictionarySegment& segment, const size_t begin,
+                                                      const size_t end, const ChunkOffsetOf& chunk_offset_of,
+                                                      const Functor& func) {
+  const auto& attribute_vector = *segment.attribute_vector();
+  auto block_cache = FrontCodedBlockCache{*segment.dictionary()};
+  for (auto index = begin; index < end; ++index) func(block_cache.get(attribute_vector.get(chunk_offset_of(index))));
+}
+
+// get() of GorillaSegment and of delta-encoded FrameOfReferenceSegment decodes the block up to the row. Instead, the
+// block of the last position is kept, which serves the following positions of sorted position lists.
+template <typename T, typename Segment, typename ChunkOffsetOf, typename Functor>
+void iterate_block_segment_positions(const Segment& segment, const size_t begin, const size_t end,
+                                     const ChunkOffsetOf& chunk_offset_of, const Functor& func) {
+  auto values = std::vector<T>(Segment::block_size);
+  auto decoded_block_index = std::numeric_limits<size_t>::max();
+  for (auto index = begin; index < end; ++index) {
+    const auto chunk_offset = chunk_offset_of(index);
+    const auto block_index = chunk_offset / Segment::block_size;
+    if (block_index != decoded_block_index) {
+      segment.decode_block(block_index, values.data());
+      decoded_block_index = block_index;
+    }
+    func(values[chunk_offset % Segment::block_size]);
+  }
+}
+
+template <typename T, typename ChunkOffsetOf, typename Functor>
+void iterate_frame_of_reference_segment_positions(const FrameOfReferenceSegment<T>& segment, const size_t begin,
+                                                  const size_t end, const ChunkOffsetOf& chunk_offset_of,
+                                                  const Functor& func) {
+  if (segment.is_delta()) return iterate_block_segment_positions<T>(segment, begin, end, chunk_offset_of, func);
+  for (auto index = begin; index < end; ++index) func(segment.get(chunk_offset_of(index)));
+}
+
+template <typename T, typename Segment, typename ChunkOffsetOf, typename Functor>
+void iterate_positions(const Segment& segment, const size_t begin, const size_t end,
+                       const ChunkOffsetOf& chunk_offset_of, const Functor& func) {
+  if constexpr (std::is_same_v<Segment, ValueSegment<T>>) {
+    iterate_value_segment_positions(segment, begin, end, chunk_offset_of, func);
+  } else if constexpr (std::is_same_v<Segment, DictionarySegment<T>>) {
+    iterate_dictionary_segment_positions(segment, begin, end, chunk_offset_of, func);
+  } else if constexpr (std::is_same_v<Segment, FrontCodedDictionarySegment>) {
+    iterate_front_coded_dictionary_segment_positions(segment, begin, end, chunk_offset_of, func);
+  } else if constexpr (std::is_same_v<Segment, GorillaSegment<T>>) {
+    iterate_block_segment_positions<T>(segment, begin, end, chunk_offset_of, func);
+  } else if constexpr (std::is_same_v<Segment, FrameOfReferenceSegment<T>>) {
+    iterate_frame_of_reference_segment_positions(segment, begin, end, chunk_offset_of, func);
+  } else if constexpr (std::is_same_v<Segment, ReferenceSegment>) {
+    Fail("Reference segments must not reference other reference segments");
+  } else {
+    for (auto index = begin; index < end; ++index) func(segment.get(chunk_offset_of(index)));
+  }
+}
+
+// The following functions call func(value) for each value of a segment of the respective type in order
+
+template <typename T, typename Functor>
+void iterate_value_segment(const ValueSegment<T>& segment, const Functor& func) {
+  const auto& values = segment.values();
+  const auto size = segment.size();
+  for (size_t offset = 0; offset < size; ++offset) func(values[offset]);
+}
+
+template <typename T, typename Functor>
+void iterate_dictionary_segment(const DictionarySegment<T>& segment, const Functor& func) {
+  const auto& dictionary = *segment.dictionary();
+  iterate_value_ids(*segment.attribute_vector(), [&](const ValueID value_id) { func(dictionary[value_id]); });
+}
+
+// Rows whose value id is in the same block of the dictionary as their predecessor's, e.g., in sorted or clustered
+// columns, do not decode anything
+template <typename Functor>
+void iterate_front_coded_dictionary_segment(const FrontCodedDictionarySegment& segment, const Functor& func) {
+  auto block_cache = FrontCodedBlockCache{*segment.dictionary()};
+  iterate_value_ids(*segment.attribute_vector(), [&](const ValueID value_id) { func(block_cache.get(value_id)); });
+}
+
+template <typename T, typename Functor>
+void iterate_run_length_segment(const RunLengthSegment<T>& segment, const Functor& func) {
+  const auto& values = *segment.values();
+  const auto& end_positions = *segment.end_positions();
+  auto offset = ChunkOffset{0};
+  for (size_t run = 0; run < values.size(); ++run) {
+    for (; offset <= end_positions[run]; ++offset) func(values[run]);
+  }
+}
+
+// FrameOfReferenceSegment and GorillaSegment are decoded a block at a time
+template <typename T, typename Segment, typename Functor>
+void iterate_block_segment(const Segment& segment, const Functor& func) {
+  auto values = std::vector<T>(Segment::block_size);
+  for (size_t block_index = 0; block_index < segment.block_count(); ++block_index) {
+    segment.decode_block(block_index, values.data());
+    const auto count = std::min(size_t{Segment::block_size}, segment.size() - block_index * Segment::block_size);
+    for (size_t index = 0; index < count; ++index) func(values[index]);
+  }
+}
+
+template <typename Functor>
+void iterate_contiguous_string_segment(const ContiguousStringSegment& segment, const Functor& func) {
+  const auto strings = segment.strings();
+  for (size_t offset = 0; offset < strings.size(); ++offset) func(strings[offset]);
+}
+
+// The referenced segment is resolved once per run of positions in the same chunk, or once for a SingleChunkPosList
+template <typename T, typename Functor>
+void iterate_reference_segment(const ReferenceSegment& segment, const Functor& func) {
+  const auto& table = *segment.referenced_table();
+  if (const auto single_chunk_pos_list = segment.single_chunk_pos_list()) {
+    const auto& chunk_offsets = single_chunk_pos_list->chunk_offsets;
+    const auto& referenced_segment =
+        *table.get_chunk(single_chunk_pos_list->chunk_id).get_segment(segment.referenced_column_id());
+    resolve_segment_type<T>(referenced_segment, [&](const auto& typed_referenced_segment) {
+      iterate_positions<T>(typed_referenced_segment, 0, chunk_offsets.size(),
+                           [&](const size_t index) { return chunk_offsets[index]; }, func);
+    });
+    return;
+  }
+
+  const auto& pos_list = *segment.pos_list();
+  for (size_t begin = 0; begin < pos_list.size();) {
+    const auto chunk_id = pos_list[begin].chunk_id;
+    auto end = begin + 1;
+    while (end < pos_list.size() && pos_list[end].chunk_id == chunk_id) ++end;
+
+    const auto& referenced_segment = *table.get_chunk(chunk_id).get_segment(segment.referenced_column_id());
+    resolve_segment_type<T>(referenced_segment, [&](const auto& typed_referenced_segment) {
+      iterate_positions<T>(typed_referenced_segment, begin, end,
+                           [&](const size_t index) { return pos_list[index].chunk_offset; }, func);
+    });
+    begin = end;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Calls func(value) for each value of a segment whose values are of type T, in the order of the rows. The type of the
+ * segment is resolved once, and each segment type is read sequentially by a loop that is instantiated for func:
+ * dictionary segments look up the value ids of their attribute vector, run-length segments repeat the value of each
+ * run, and frame-of-reference and Gorilla segments as well as front-coded dictionaries decode a block at a time. The
+ * values of a ReferenceSegment are those of the referenced rows; the referenced segment is resolved once per run of
+ * positions in the same chunk, or once if the positions are a SingleChunkPosList, and blocks that were decoded for a
+ * position are kept for the following ones.
+ *
+ * Strings of a ContiguousStringSegment are passed as std::string_view, so func has to accept it for T = std::string,
+ * e.g., by taking const auto& and constructing a T if it needs one.
+ *
+ * Example:
+ *
+ *   auto sum = T{};
+ *   segment_iterate<T>(segment, [&](const auto& value) { sum += value; });
+ */
+template <typename T, typename Functor>
+void segment_iterate(const BaseSegment& segment, const Functor& func) {
+  resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+    using Segment = std::decay_t<decltype(typed_segment)>;
+    if constexpr (std::is_same_v<Segment, ValueSegment<T>>) {
+      detail::iterate_value_segment(typed_segment, func);
+    } else if constexpr (std::is_same_v<Segment, DictionarySegment<T>>) {
+      detail::iterate_dictionary_segment(typed_segment, func);
+    } else if constexpr (std::is_same_v<Segment, FrontCodedDictionarySegment>) {
+      detail::iterate_front_coded_dictionary_segment(typed_segment, func);
+    } else if constexpr (std::is_same_v<Segment, RunLengthSegment<T>>) {
+      detail::iterate_run_length_segment(typed_segment, func);
+    } else if constexpr (std::is_same_v<Segment, ContiguousStringSegment>) {
+      detail::iterate_contiguous_string_segment(typed_segment, func);
+    } else if constexpr (std::is_same_v<Segment, ReferenceSegment>) {
+      detail::iterate_reference_segment<T>(typed_segment, func);
+    } else {
+      detail::iterate_block_segment<T>(typed_segment, func);
+    }
+  });
+}
+
+}  // namespace opossum
@@ -0,0 +1,35 @@
+#include "segment_statistics.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "contiguous_string_segment.hpp"
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+std::shared_ptr<BaseSegmentStatistics> create_segment_statistics(const std::string& type,
+                                                                 const std::shared_ptr<BaseSegment>& segment,
+                                                                 const uint32_t bloom_filter_bits_per_value) {
+  std::shared_ptr<BaseSegmentStatistics> statistics;
+  resolve_data_type(type, [&](auto data_type) {
+    using DataType = typename decltype(data_type)::type;
+    if constexpr (std::is_same<DataType, std::string>::value) {
+      if (const auto string_segment = std::dynamic_pointer_cast<const ContiguousStringSegment>(segment)) {
+        statistics = std::make_shared<SegmentStatistics<DataType>>(string_segment->strings(),
+                                                                   bloom_filter_bits_per_value);
+        return;
+      }
+    }
+
+    const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<DataType>>(segment);
+    Assert(static_cast<bool>(value_segment), "Statistics can only be created for unencoded segments");
+    statistics = std::make_shared<SegmentStatistics<DataType>>(value_segment->values(), bloom_filter_bits_per_value);
+  });
+  return statistics;
+}
+
+}  // namespace opossum
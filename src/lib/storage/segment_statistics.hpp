@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bloom_filter.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+
+// Result of checking a predicate against the statistics of a segment
+enum class PredicateMatch { None, All, Some };
+
+// BaseSegmentStatistics is the abstract super class of the statistics that a chunk keeps per segment
+class BaseSegmentStatistics : private Noncopyable {
+ public:
+  explicit BaseSegmentStatistics(const size_t row_count) : _row_count(row_count) {}
+  virtual ~BaseSegmentStatistics() = default;
+
+  // returns the number of rows of the segment
+  size_t row_count() const { return _row_count; }
+
+ protected:
+  const size_t _row_count;
+};
+
+// SegmentStatistics keep the minimum and maximum value of a segment (a zone map). Scans use them to skip segments in
+// which no row can match the predicate, or to accept all rows without looking at the segment. Optionally, they also
+// keep a Bloom filter of the values, which decides equality predicates that fall between the minimum and maximum.
+template <typename T>
+class SegmentStatistics : public BaseSegmentStatistics {
+ public:
+  // values holds the rows as T or, for strings, as std::string_view, e.g., a ContiguousStrings view
+  // bloom_filter_bits_per_value = 0 creates no Bloom filter
+  template <typename Values = std::vector<T>>
+  explicit SegmentStatistics(const Values& values, const uint32_t bloom_filter_bits_per_value = 0)
+      : BaseSegmentStatistics(values.size()) {
+    // std::hash of a std::string_view equals that of the std::string with the same characters
+    using Value = std::decay_t<decltype(values[0])>;
+    if (bloom_filter_bits_per_value > 0) {
+      _bloom_filter = std::make_shared<BloomFilter>(values.size(), bloom_filter_bits_per_value);
+      for (size_t index = 0; index < values.size(); ++index) {
+        _bloom_filter->insert(std::hash<Value>{}(values[index]));
+      }
+    }
+
+    for (size_t index = 0; index < values.size(); ++index) {
+      const auto& value = values[index];
+      // NaN does not compare to anything, so it is excluded from the minimum and maximum
+      if constexpr (std::is_floating_point<T>::value) {
+        if (std::isnan(value)) {
+          _contains_nan = true;
+          continue;
+        }
+      }
+
+      if (!_has_min_max) {
+        _min = value;
+        _max = value;
+        _has_min_max = true;
+      } else if (value < _min) {
+        _min = value;
+      } else if (_max < value) {
+        _max = value;
+      }
+    }
+  }
+
+  // Restores statistics that were created before, e.g., when loading a snapshot
+  SegmentStatistics(const size_t row_count, const T& min, const T& max, const bool has_min_max, const bool contains_nan,
+                    std::shared_ptr<BloomFilter> bloom_filter)
+      : BaseSegmentStatistics(row_count),
+        _min(min),
+        _max(max),
+        _has_min_max(has_min_max),
+        _contains_nan(contains_nan),
+        _bloom_filter(std::move(bloom_filter)) {}
+
+  // returns the smallest value. Only valid if has_min_max() is true.
+  const T& min() const { return _min; }
+
+  // returns the largest value. Only valid if has_min_max() is true.
+  const T& max() const { return _max; }
+
+  // returns false if the segment is empty or only contains NaN
+  bool has_min_max() const { return _has_min_max; }
+
+  // returns true if the segment contains NaN
+  bool contains_nan() const { return _contains_nan; }
+
+  // returns the Bloom filter of the values, or nullptr if there is none
+  std::shared_ptr<const BloomFilter> bloom_filter() const { return _bloom_filter; }
+
+  // Returns whether none, all, or some rows of the segment might satisfy `value <scan_type> search_value`
+  template <ScanType scan_type>
+  PredicateMatch match(const T& search_value) const {
+    if (!_has_min_max) {
+      // Only NaN rows, which satisfy OpNotEquals only
+      if (_row_count > 0 && scan_type == ScanType::OpNotEquals) return PredicateMatch::All;
+      return PredicateMatch::None;
+    }
+
+    auto result = PredicateMatch::Some;
+    switch (scan_type) {
+      case ScanType::OpEquals:
+        if (search_value < _min || _max < search_value) result = PredicateMatch::None;
+        if (_min == search_value && _max == search_value) result = PredicateMatch::All;
+        break;
+      case ScanType::OpNotEquals:
+        if (search_value < _min || _max < search_value) result = PredicateMatch::All;
+        if (_min == search_value && _max == search_value) result = PredicateMatch::None;
+        break;
+      case ScanType::OpLessThan:
+        if (_max < search_value) result = PredicateMatch::All;
+        if (!(_min < search_value)) result = PredicateMatch::None;
+        break;
+      case ScanType::OpLessThanEquals:
+        if (!(search_value < _max)) result = PredicateMatch::All;
+        if (search_value < _min) result = PredicateMatch::None;
+        break;
+      case ScanType::OpGreaterThan:
+        if (search_value < _min) result = PredicateMatch::All;
+        if (!(search_value < _max)) result = PredicateMatch::None;
+        break;
+      case ScanType::OpGreaterThanEquals:
+        if (!(_min < search_value)) result = PredicateMatch::All;
+        if (_max < search_value) result = PredicateMatch::None;
+        break;
+    }
+
+    // A value that is not in the Bloom filter does not occur in the segment
+    if ((scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals) && result == PredicateMatch::Some &&
+        _bloom_filter && !_bloom_filter->may_contain(std::hash<T>{}(search_value))) {
+      result = scan_type == ScanType::OpEquals ? PredicateMatch::None : PredicateMatch::All;
+    }
+
+    // NaN rows only satisfy OpNotEquals. A comparison with a NaN search value is never decided by the statistics.
+    if constexpr (std::is_floating_point<T>::value) {
+      if (std::isnan(search_value)) return PredicateMatch::Some;
+      if (_contains_nan) {
+        if (scan_type == ScanType::OpNotEquals && result == PredicateMatch::None) return PredicateMatch::Some;
+        if (scan_type != ScanType::OpNotEquals && result == PredicateMatch::All) return PredicateMatch::Some;
+      }
+    }
+    return result;
+  }
+
+ protected:
+  T _min{};
+  T _max{};
+  bool _has_min_max = false;
+  bool _contains_nan = false;
+  std::shared_ptr<BloomFilter> _bloom_filter;
+};
+
+// Creates the SegmentStatistics of an unencoded segment of the given data type, i.e., of a ValueSegment or a
+// ContiguousStringSegment
+std::shared_ptr<BaseSegmentStatistics> create_segment_statistics(const std::string& type,
+                                                                 const std::shared_ptr<BaseSegment>& segment,
+                                                                 const uint32_t bloom_filter_bits_per_value = 0);
+
+}  // namespace opossum
@@ -1,58 +1,172 @@
 #include "storage_manager.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "segment_encoding_utils.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Returns the counter that the calling thread registers in as a reader. Threads are spread round robin.
+size_t reader_stripe(const size_t stripe_count) {
+  static auto next_stripe = std::atomic<size_t>{0};
+  thread_local const auto stripe = next_stripe++;
+  return stripe % stripe_count;
+}
+
+}  // namespace
+
 StorageManager& StorageManager::get() {
   static StorageManager storage_manager;
   return storage_manager;
 }
 
-void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) { _tables[name] = table; }
+template <typename Functor>
+auto StorageManager::_read(const Functor& func) const {
+  // A writer that frees a map first waits for the counters of both epochs, see _wait_for_readers. Registering before
+  // loading the map, both sequentially consistent, guarantees that the writer either waits for this reader or that
+  // the reader loads the new map.
+  auto& reader_count = _reader_counts[_epoch.load() & 1][reader_stripe(_reader_stripe_count)].count;
+  ++reader_count;
+  // Unregisters also if func throws
+  struct Unregister {
+    ~Unregister() { --count; }
+    std::atomic<uint32_t>& count;
+  } unregister{reader_count};
+  return func(*_tables.load());
+}
+
+void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) {
+  std::lock_guard<std::mutex> lock(_write_mutex);
+  auto tables = std::make_unique<TableMap>(*_owned_tables);
+  (*tables)[name] = std::move(table);
+  _publish(std::move(tables));
+}
 
 void StorageManager::drop_table(const std::string& name) {
-  if (!_tables.erase(name)) {
+  std::lock_guard<std::mutex> lock(_write_mutex);
+  auto tables = std::make_unique<TableMap>(*_owned_tables);
+  if (!tables->erase(name)) {
     throw std::runtime_error("Table does not exist");
   }
+  _publish(std::move(tables));
 }
 
 std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
-  if (!has_table(name)) {
+  auto table = _read([&](const TableMap& tables) {
+    const auto entry = tables.find(name);
+    return entry == tables.cend() ? nullptr : entry->second;
+  });
+  if (!table) {
     throw std::runtime_error("Table does not exist");
   }
-  return _tables.at(name);
+  return table;
 }
 
 bool StorageManager::has_table(const std::string& name) const {
-  if (_tables.count(name) == 0) {
-    return false;
-  }
-  return true;
+  return _read([&](const TableMap& tables) { return tables.count(name) != 0; });
 }
 
 std::vector<std::string> StorageManager::table_names() const {
-  std::vector<std::string> keys;
-  keys.reserve(_tables.size());
-  for (const auto& table : _tables) {
-    keys.push_back(table.first);
-  }
-  return keys;
+  return _read([](const TableMap& tables) {
+    std::vector<std::string> keys;
+    keys.reserve(tables.size());
+    for (const auto& table : tables) {
+      keys.push_back(table.first);
+    }
+    return keys;
+  });
 }
 
 void StorageManager::print(std::ostream& out) const {
-  for (const auto& table : _tables) {
+  for (const auto& table : _snapshot()) {
     out << table.first << ", columns: " << table.second->column_count() << ", rows: " << table.second->row_count()
-        << ", chunks: " << table.second->chunk_count() << std::endl;
+        << ", chunks: " << table.second->chunk_count() << ", bytes: " << table.second->estimate_memory_usage()
+        << std::endl;
   }
 }
 
-void StorageManager::reset() { _tables.clear(); }
+std::vector<SegmentMemoryUsage> StorageManager::memory_usage() const {
+  std::vector<SegmentMemoryUsage> memory_usage;
+  for (const auto& [table_name, table] : _snapshot()) {
+    for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+      // Columns have only a few encodings, so the entries are searched linearly
+      const auto first_entry = memory_usage.size();
+      for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+        const auto segment = table->get_chunk(chunk_id).get_segment(column_id);
+        const auto encoding = segment_encoding_name(table->column_type(column_id), segment);
+
+        auto entry = std::find_if(memory_usage.begin() + first_entry, memory_usage.end(),
+                                  [&](const auto& usage) { return usage.encoding == encoding; });
+        if (entry == memory_usage.end()) {
+          memory_usage.push_back({table_name, table->column_name(column_id), encoding, 0, 0, 0});
+          entry = memory_usage.end() - 1;
+        }
+        ++entry->segment_count;
+        entry->row_count += segment->size();
+        entry->bytes += segment->estimate_memory_usage();
+      }
+      std::sort(memory_usage.begin() + first_entry, memory_usage.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.encoding < rhs.encoding; });
+    }
+  }
+  return memory_usage;
+}
+
+void StorageManager::print_memory_usage(std::ostream& out) const {
+  for (const auto& usage : memory_usage()) {
+    out << usage.table_name << "." << usage.column_name << ", encoding: " << usage.encoding
+        << ", segments: " << usage.segment_count << ", rows: " << usage.row_count << ", bytes: " << usage.bytes
+        << std::endl;
+  }
+}
+
+void StorageManager::print_encoding_report(std::ostream& out) const {
+  for (const auto& [table_name, table] : _snapshot()) {
+    for (const auto& decision : table->encoding_report()) {
+      out << table_name << "." << table->column_name(decision.column_id) << ", chunk: " << decision.chunk_id
+          << ", encoding: " << decision.encoding << (decision.is_column_override ? " (column encoding)" : "")
+          << ", bytes: " << decision.unencoded_bytes << " -> " << decision.encoded_bytes
+          << ", ratio: " << decision.compression_ratio() << std::endl;
+    }
+  }
+}
+
+void StorageManager::reset() {
+  std::lock_guard<std::mutex> lock(_write_mutex);
+  _publish(std::make_unique<const TableMap>());
+}
+
+StorageManager::TableMap StorageManager::_snapshot() const {
+  return _read([](const TableMap& tables) { return tables; });
+}
+
+void StorageManager::_publish(std::unique_ptr<const TableMap> tables) {
+  _tables = tables.get();
+  _wait_for_readers();
+  _owned_tables = std::move(tables);
+}
+
+void StorageManager::_wait_for_readers() {
+  // Readers that loaded the epoch before it was flipped may still register in the counters of the previous epoch.
+  // Flipping twice and waiting for each epoch's counters to drop to zero once covers every reader that registered
+  // before the call, while new readers register in the other epoch and do not delay the writer.
+  for (auto flip = 0; flip < 2; ++flip) {
+    const auto previous_epoch = _epoch.load() & 1;
+    _epoch.store(previous_epoch ^ 1);
+    for (const auto& reader_count : _reader_counts[previous_epoch]) {
+      while (reader_count.count.load() != 0) std::this_thread::yield();
+    }
+  }
+}
 
 }  // namespace opossum
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -11,8 +14,22 @@
 
 namespace opossum {
 
+// The memory that the segments of one column of a table occupy, for one encoding
+struct SegmentMemoryUsage {
+  std::string table_name;
+  std::string column_name;
+  std::string encoding;
+  size_t segment_count;
+  uint64_t row_count;
+  size_t bytes;
+};
+
 // The StorageManager is a singleton that maintains all tables
 // by mapping table names to table instances.
+// It can be used by many threads at once. Lookups read an immutable map without locking: they only count themselves
+// in a reader counter while they search the map. Threads that add or drop tables copy the map, publish the copy, and
+// free the previous map once the readers that may still use it are done (see _wait_for_readers). Tables that are
+// dropped stay alive as long as someone holds them.
 class StorageManager : private Noncopyable {
  public:
   static StorageManager& get();
@@ -32,18 +49,59 @@ class StorageManager : private Noncopyable {
   // returns a list of all table names
   std::vector<std::string> table_names() const;
 
-  // prints information about all tables in the storage manager (name, #columns, #rows, #chunks)
+  // prints information about all tables in the storage manager (name, #columns, #rows, #chunks, estimated bytes)
   void print(std::ostream& out = std::cout) const;
 
+  // Returns the estimated memory usage of all tables, broken down by column and encoding (see segment_encoding_name).
+  // The entries are sorted by table name, then ordered by column, then sorted by encoding.
+  std::vector<SegmentMemoryUsage> memory_usage() const;
+
+  // prints memory_usage() with one line per table, column, and encoding
+  void print_memory_usage(std::ostream& out = std::cout) const;
+
+  // prints the encoding report of every table (see Table::encoding_report) with one line per segment that was encoded
+  void print_encoding_report(std::ostream& out = std::cout) const;
+
   // deletes the entire StorageManager and creates a new one, used especially in tests
   void reset();
 
   StorageManager(StorageManager&&) = delete;
 
  protected:
+  using TableMap = std::map<std::string, std::shared_ptr<Table>>;
+
+  // Number of counters per epoch that readers spread over, so that they do not all increment the same one
+  static constexpr size_t _reader_stripe_count = 16;
+
+  struct alignas(64) ReaderCount {
+    std::atomic<uint32_t> count{0};
+  };
+
   StorageManager() {}
-  StorageManager& operator=(StorageManager&&) = default;
+  StorageManager& operator=(StorageManager&&) = delete;
+
+  // Calls func(tables) with the current map, which is not freed before func returns. func must not add or drop tables.
+  template <typename Functor>
+  auto _read(const Functor& func) const;
+
+  // returns a copy of the current map, for callers that use it for longer than a lookup
+  TableMap _snapshot() const;
+
+  // Publishes tables as the current map and frees the previous one. Has to be called with _write_mutex locked.
+  void _publish(std::unique_ptr<const TableMap> tables);
+
+  // Waits until no reader uses a map that was current before the call
+  void _wait_for_readers();
+
+  // The map is never modified once it is published, only replaced. _tables points to the map that _owned_tables owns.
+  std::unique_ptr<const TableMap> _owned_tables = std::make_unique<const TableMap>();
+  std::atomic<const TableMap*> _tables{_owned_tables.get()};
+
+  // Readers register in a counter of the current epoch while they use the map
+  std::atomic<uint32_t> _epoch{0};
+  mutable std::array<std::array<ReaderCount, _reader_stripe_count>, 2> _reader_counts;
 
-  std::map<std::string, std::shared_ptr<Table>> _tables;
+  // serializes the threads that replace the map
+  std::mutex _write_mutex;
 };
 }  // namespace opossum
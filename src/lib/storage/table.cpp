@@ -1,10 +1,14 @@
 #include "table.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,46 +16,227 @@
 #include "value_segment.hpp"
 
 #include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "segment_encoding_utils.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
-Table::Table(const uint32_t chunk_size) : _chunks{std::make_shared<Chunk>()}, _chunk_size(chunk_size) {}
+namespace {
+
+// Number of rows that a chunk allocates at least when rows are appended to it. Chunks grow geometrically, so that
+// copying their rows to larger segments amortizes.
+constexpr ChunkOffset min_chunk_capacity = 1024;
+
+}  // namespace
+
+Table::Table(const uint32_t chunk_size) : _chunk_size(chunk_size) { _chunks.push_back(_create_appendable_chunk()); }
+
+Table::Table(Table&& other)
+    : _chunks(std::move(other._chunks)),
+      _column_names(std::move(other._column_names)),
+      _types(std::move(other._types)),
+      _column_encodings(std::move(other._column_encodings)),
+      _chunk_size(other._chunk_size),
+      _auto_compression(std::move(other._auto_compression)),
+      _background_compressions(std::move(other._background_compressions)),
+      _background_encoded_chunk_ids(std::move(other._background_encoded_chunk_ids)),
+      _encoding_log(std::move(other._encoding_log)) {}
 
 void Table::add_column_definition(const std::string& name, const std::string& type) {
   _column_names.emplace_back(name);
   _types.emplace_back(type);
+  _column_encodings.emplace_back(std::nullopt);
 }
 
 void Table::add_column(const std::string& name, const std::string& type) {
   _column_names.push_back(name);
   _types.push_back(type);
+  _column_encodings.push_back(std::nullopt);
   for (uint32_t entry = 0; entry < chunk_count(); ++entry) {
-    get_chunk(ChunkID{entry}).add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
+    auto& chunk = get_chunk(ChunkID{entry});
+    if (chunk.accepts_appends()) {
+      DebugAssert(chunk.append_capacity() == 0, "Columns can only be added to empty tables");
+      chunk.add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type, chunk.visible_row_count()));
+    } else {
+      chunk.add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
+    }
+  }
+}
+
+template <typename RowWriter>
+void Table::_append_rows(const size_t row_count, const RowWriter& write_rows) {
+  size_t appended_row_count = 0;
+  while (appended_row_count < row_count) {
+    const auto chunk = _chunks.back();
+    const auto requested_row_count =
+        static_cast<ChunkOffset>(std::min(row_count - appended_row_count, size_t{_max_chunk_row_count()}));
+
+    const auto reservation = chunk->reserve_rows(requested_row_count);
+    if (reservation.second == 0) {
+      _extend_chunks(chunk, reservation.first, requested_row_count);
+      continue;
+    }
+
+    write_rows(*chunk, reservation.first, appended_row_count, reservation.second);
+    chunk->publish_rows(reservation.first, reservation.second);
+    appended_row_count += reservation.second;
   }
 }
 
 void Table::append(std::vector<AllTypeVariant> values) {
-  if (_chunks.back()->size() == chunk_size()) {
-    _chunks.push_back(std::make_shared<Chunk>());
-    for (const auto& type : _types) {
-      _chunks.back()->add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type));
+  DebugAssert(values.size() == _types.size(), "Wrong number of entries");
+
+  // Converting the values before reserving a row keeps the writing from failing
+  for (ColumnID column_id{0}; column_id < values.size(); ++column_id) {
+    resolve_data_type(_types[column_id], [&](auto type) {
+      values[column_id] = type_cast<typename decltype(type)::type>(values[column_id]);
+    });
+  }
+
+  _append_rows(1, [&](Chunk& chunk, const ChunkOffset offset, const size_t, const ChunkOffset) {
+    for (ColumnID column_id{0}; column_id < values.size(); ++column_id) {
+      resolve_data_type(_types[column_id], [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        // Chunks that are appended to only hold ValueSegments
+        std::static_pointer_cast<ValueSegment<ColumnDataType>>(chunk.get_segment(column_id))
+            ->write_values(offset, &boost::get<ColumnDataType>(values[column_id]), 1);
+      });
+    }
+  });
+}
+
+void Table::append_columns(const std::vector<AllTypeValueSpan>& columns) {
+  DebugAssert(columns.size() == _types.size(), "Wrong number of columns");
+  if (columns.empty()) return;
+
+  const auto row_count = boost::apply_visitor([](const auto& span) { return span.size(); }, columns[0]);
+  for (ColumnID column_id{0}; column_id < columns.size(); ++column_id) {
+    resolve_data_type(_types[column_id], [&](auto type) {
+      const auto span = boost::get<ValueSpan<typename decltype(type)::type>>(&columns[column_id]);
+      Assert(span && span->size() == row_count, "Column " + _column_names[column_id] + " does not match");
+    });
+  }
+
+  _append_rows(row_count, [&](Chunk& chunk, const ChunkOffset offset, const size_t first_row, const ChunkOffset count) {
+    for (ColumnID column_id{0}; column_id < columns.size(); ++column_id) {
+      resolve_data_type(_types[column_id], [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        const auto& span = boost::get<ValueSpan<ColumnDataType>>(columns[column_id]);
+        std::static_pointer_cast<ValueSegment<ColumnDataType>>(chunk.get_segment(column_id))
+            ->write_values(offset, span.data() + first_row, count);
+      });
     }
+  });
+}
+
+void Table::_extend_chunks(const std::shared_ptr<Chunk>& chunk, const ChunkOffset reserved_row_count,
+                           const ChunkOffset row_count) {
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  // Another writer may have grown the chunk or added a new one in the meantime
+  if (chunk != _chunks.back() || chunk->append_capacity() > reserved_row_count) return;
+
+  const auto capacity = uint64_t{chunk->append_capacity()};
+  const auto max_row_count = uint64_t{_max_chunk_row_count()};
+  if (chunk->accepts_appends() && capacity < max_row_count) {
+    // The rows that are still being written have to be copied, too
+    chunk->wait_for_reserved_rows();
+    const auto new_capacity =
+        std::min(max_row_count, std::max({capacity * 2, capacity + row_count, uint64_t{min_chunk_capacity}}));
+    _reallocate_segments(*chunk, static_cast<ChunkOffset>(new_capacity));
+    chunk->set_append_capacity(static_cast<ChunkOffset>(new_capacity));
+    return;
+  }
+
+  _finish_chunk(chunk);
+  _chunks.push_back(_create_appendable_chunk());
+}
+
+std::shared_ptr<Chunk> Table::_create_appendable_chunk() const {
+  auto chunk = std::make_shared<Chunk>();
+  chunk->set_append_capacity(0);
+  for (const auto& type : _types) {
+    chunk->add_segment(make_shared_by_data_type<BaseSegment, ValueSegment>(type, chunk->visible_row_count()));
+  }
+  return chunk;
+}
+
+void Table::_reallocate_segments(Chunk& chunk, const ChunkOffset capacity) const {
+  const auto row_count = chunk.size();
+  const auto segments = chunk.segments();
+  auto new_segments = Chunk::Segments{};
+  for (ColumnID column_id{0}; column_id < segments->size(); ++column_id) {
+    resolve_data_type(_types[column_id], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      const auto value_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>((*segments)[column_id]);
+      Assert(static_cast<bool>(value_segment), "Rows can only be appended to value segments");
+      const auto& values = value_segment->values();
+
+      // Readers may still access the old segment, so its values are copied rather than moved
+      auto new_values = std::vector<ColumnDataType>{};
+      new_values.reserve(capacity);
+      new_values.assign(values.cbegin(), values.cbegin() + row_count);
+      new_values.resize(capacity);
+      new_segments.push_back(
+          std::make_shared<ValueSegment<ColumnDataType>>(chunk.visible_row_count(), std::move(new_values)));
+    });
+  }
+  chunk.replace_segments(std::move(new_segments));
+}
+
+void Table::_close_chunk(Chunk& chunk) const {
+  if (!chunk.accepts_appends()) return;
+  const auto row_count = chunk.finish_appends();
+  if (chunk.append_capacity() > row_count) _reallocate_segments(chunk, row_count);
+}
+
+void Table::_finish_chunk(const std::shared_ptr<Chunk>& chunk) {
+  _close_chunk(*chunk);
+  // Chunks that were compressed already have their statistics
+  if (chunk->has_statistics()) return;
+
+  const auto bloom_filter_bits_per_value = _auto_compression ? _auto_compression->bloom_filter_bits_per_value : 0;
+  chunk->set_statistics(_create_statistics(*chunk, bloom_filter_bits_per_value));
+
+  if (_auto_compression && chunk->size() > 0) {
+    // Finished encodings are not waited for anymore
+    _background_compressions.erase(
+        std::remove_if(_background_compressions.begin(), _background_compressions.end(),
+                       [](const auto& future) {
+                         return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                       }),
+        _background_compressions.end());
+
+    // The job does not refer to the table, which may be destroyed before the chunk is encoded
+    DebugAssert(chunk == _chunks.back(), "Only the last chunk can be finished");
+    const auto chunk_id = ChunkID{_chunks.size() - 1};
+    _background_encoded_chunk_ids.emplace(chunk_id);
+    _background_compressions.emplace_back(WorkerPool::get().schedule(
+        [chunk, chunk_id, column_types = _types, column_encodings = _column_encodings,
+         spec = *_auto_compression, encoding_log = _encoding_log]() {
+          _encode_chunk(*chunk, chunk_id, column_types, column_encodings, spec, *encoding_log);
+        }));
   }
-  _chunks.back()->append(values);
+}
+
+ChunkOffset Table::_max_chunk_row_count() const {
+  return chunk_size() == 0 ? std::numeric_limits<ChunkOffset>::max() - 1 : chunk_size();
 }
 
 uint16_t Table::column_count() const { return _chunks[0]->column_count(); }
 
 void Table::create_new_chunk() {
-  // Implementation goes here
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  // the last chunk will not change anymore
+  _finish_chunk(_chunks.back());
+  _chunks.push_back(_create_appendable_chunk());
 }
 
 uint64_t Table::row_count() const {
   uint64_t rows = 0;
-  for (const auto& chunk : _chunks) {
-    rows += chunk->size();
+  for (size_t chunk_index = 0; chunk_index < _chunks.size(); ++chunk_index) {
+    rows += _chunks[chunk_index]->size();
   }
   return rows;
 }
@@ -69,6 +254,14 @@ ColumnID Table::column_id_by_name(const std::string& column_name) const {
 
 uint32_t Table::chunk_size() const { return _chunk_size; }
 
+size_t Table::estimate_memory_usage() const {
+  auto bytes = sizeof(*this);
+  for (size_t chunk_index = 0; chunk_index < _chunks.size(); ++chunk_index) {
+    bytes += _chunks[chunk_index]->estimate_memory_usage();
+  }
+  return bytes;
+}
+
 const std::vector<std::string>& Table::column_names() const { return _column_names; }
 
 const std::string& Table::column_name(ColumnID column_id) const { return _column_names[column_id]; }
@@ -79,20 +272,112 @@ Chunk& Table::get_chunk(ChunkID chunk_id) { return *_chunks[chunk_id]; }
 
 const Chunk& Table::get_chunk(ChunkID chunk_id) const { return *_chunks[chunk_id]; }
 
-void Table::compress_chunk(ChunkID chunk_id) {
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
+void Table::compress_chunk(ChunkID chunk_id, const SegmentEncodingSpec& spec) {
+  auto& chunk = *_chunks[chunk_id];
+  auto column_encodings = std::vector<std::optional<SegmentEncodingSpec>>{};
+  {
+    // Encoded segments cannot be appended to, further rows go to a new chunk
+    std::lock_guard<std::mutex> lock(_append_mutex);
+    Assert(!_background_encoded_chunk_ids.count(chunk_id), "Chunk is encoded in the background");
+    _close_chunk(chunk);
+    column_encodings = _column_encodings;
+    // A chunk with statistics is not encoded in the background once an appender finishes it
+    chunk.set_statistics(_create_statistics(chunk, spec.bloom_filter_bits_per_value));
+  }
+  _encode_chunk(chunk, chunk_id, _types, column_encodings, spec, *_encoding_log);
+}
+
+void Table::set_auto_compression(const std::optional<SegmentEncodingSpec>& spec) {
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  _auto_compression = spec;
+}
+
+std::optional<SegmentEncodingSpec> Table::auto_compression() const {
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  return _auto_compression;
+}
+
+void Table::wait_for_background_compression() {
+  auto background_compressions = std::vector<std::future<void>>{};
+  {
+    std::lock_guard<std::mutex> lock(_append_mutex);
+    background_compressions = std::move(_background_compressions);
+    _background_compressions.clear();
+  }
+  for (auto& future : background_compressions) {
+    future.get();
+  }
+}
+
+void Table::set_column_encoding(ColumnID column_id, const std::optional<SegmentEncodingSpec>& spec) {
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  _column_encodings[column_id] = spec;
+}
 
-  auto new_chunk = std::make_shared<Chunk>();
-  for (ColumnID index = ColumnID{0}; index < _chunks[chunk_id]->column_count(); ++index) {
-    new_chunk->add_segment(make_shared_by_data_type<BaseSegment, DictionarySegment>(
-        column_type(index), _chunks[chunk_id]->get_segment(index)));
+std::optional<SegmentEncodingSpec> Table::column_encoding(ColumnID column_id) const {
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  return _column_encodings[column_id];
+}
+
+std::vector<EncodingDecision> Table::encoding_report() const {
+  std::lock_guard<std::mutex> lock(_encoding_log->mutex);
+  auto report = std::vector<EncodingDecision>{};
+  report.reserve(_encoding_log->decisions.size());
+  for (const auto& entry : _encoding_log->decisions) {
+    report.emplace_back(entry.second);
   }
-  _chunks[chunk_id] = new_chunk;
+  return report;
 }
 
-void emplace_chunk(Chunk chunk) {
-  // Implementation goes here
+void Table::_encode_chunk(Chunk& chunk, const ChunkID chunk_id, const std::vector<std::string>& column_types,
+                          const std::vector<std::optional<SegmentEncodingSpec>>& column_encodings,
+                          const SegmentEncodingSpec& spec, EncodingLog& encoding_log) {
+  const auto segments = chunk.segments();
+  auto encoded_segments = Chunk::Segments{};
+  auto decisions = std::vector<EncodingDecision>{};
+  for (ColumnID column_id{0}; column_id < segments->size(); ++column_id) {
+    const auto& type = column_types[column_id];
+    const auto& column_encoding = column_encodings[column_id];
+    const auto& segment = (*segments)[column_id];
+    const auto encoded_segment = encode_segment(type, segment, column_encoding ? *column_encoding : spec);
+    encoded_segments.push_back(encoded_segment);
+    decisions.push_back(EncodingDecision{chunk_id,
+                                         column_id,
+                                         segment_encoding_name(type, encoded_segment),
+                                         column_encoding.has_value(),
+                                         segment->estimate_memory_usage(),
+                                         encoded_segment->estimate_memory_usage()});
+  }
+
+  // Readers see the chunk either completely unencoded or completely encoded
+  chunk.replace_segments(std::move(encoded_segments));
+
+  std::lock_guard<std::mutex> lock(encoding_log.mutex);
+  for (const auto& decision : decisions) {
+    encoding_log.decisions.insert_or_assign({chunk_id, decision.column_id}, decision);
+  }
+}
+
+std::vector<std::shared_ptr<BaseSegmentStatistics>> Table::_create_statistics(
+    const Chunk& chunk, const uint32_t bloom_filter_bits_per_value) const {
+  std::vector<std::shared_ptr<BaseSegmentStatistics>> statistics;
+  statistics.reserve(chunk.column_count());
+  for (ColumnID index = ColumnID{0}; index < chunk.column_count(); ++index) {
+    statistics.emplace_back(
+        create_segment_statistics(column_type(index), chunk.get_segment(index), bloom_filter_bits_per_value));
+  }
+  return statistics;
+}
+
+void Table::emplace_chunk(Chunk chunk) {
+  DebugAssert(chunk.column_count() == _types.size(), "Wrong number of segments");
+  std::lock_guard<std::mutex> lock(_append_mutex);
+  _close_chunk(*_chunks.back());
+  if (_chunks.size() == 1 && _chunks.back()->size() == 0) {
+    _chunks.replace(0, std::make_shared<Chunk>(std::move(chunk)));
+  } else {
+    _chunks.push_back(std::make_shared<Chunk>(std::move(chunk)));
+  }
 }
 
 }  // namespace opossum
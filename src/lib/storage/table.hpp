@@ -1,16 +1,24 @@
 #pragma once
 
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "chunk_list.hpp"
 #include "dictionary_segment.hpp"
+#include "encoding_advisor.hpp"
+#include "encoding_type.hpp"
+#include "segment_statistics.hpp"
+#include "value_span.hpp"
 
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -20,7 +28,9 @@ namespace opossum {
 
 class TableStatistics;
 
-// A table is partitioned horizontally into a number of chunks
+// A table is partitioned horizontally into a number of chunks.
+// Rows can be appended by many threads at once, while other threads read the table. Appends reserve rows in the last
+// chunk without locking; only allocating more rows for a chunk and adding a new chunk are serialized.
 class Table : private Noncopyable {
  public:
   // creates a table
@@ -28,10 +38,11 @@ class Table : private Noncopyable {
   // default is the maximum chunk size minus 1. A table holds always at least one chunk
   explicit Table(const uint32_t chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
 
-  // we need to explicitly set the move constructor to default when
-  // we overwrite the copy constructor
-  Table(Table&&) = default;
-  Table& operator=(Table&&) = default;
+  // we need to explicitly define the move constructor when we overwrite the copy constructor
+  // it must not be used while other threads access the table
+  Table(Table&& other);
+  // the mutex and the chunk size cannot be assigned
+  Table& operator=(Table&&) = delete;
 
   // returns the number of columns (cannot exceed ColumnID (uint16_t))
   uint16_t column_count() const;
@@ -48,7 +59,8 @@ class Table : private Noncopyable {
   Chunk& get_chunk(ChunkID chunk_id);
   const Chunk& get_chunk(ChunkID chunk_id) const;
 
-  // Adds a chunk to the table. If the first chunk is empty, it is replaced.
+  // Adds a chunk to the table. If the first chunk is empty, it is replaced. Rows that are appended afterwards go to a
+  // new chunk. Must not be called while other threads read the table.
   void emplace_chunk(Chunk chunk);
 
   // Returns a list of all column names.
@@ -68,6 +80,9 @@ class Table : private Noncopyable {
   // return the maximum chunk size (cannot exceed ChunkOffset (uint32_t))
   uint32_t chunk_size() const;
 
+  // returns an estimate of the number of bytes that the chunks of the table occupy
+  size_t estimate_memory_usage() const;
+
   // adds column definition without creating the actual columns
   // this is helpful when, e.g., an operator first creates the structure of the table
   // and then adds chunk by chunk
@@ -79,19 +94,101 @@ class Table : private Noncopyable {
   void add_column(const std::string& name, const std::string& type);
 
   // inserts a row at the end of the table
-  // note this is slow and not thread-safe and should be used for testing purposes only
+  // note this converts every value and should not be used to load large amounts of data, see append_columns()
   void append(std::vector<AllTypeVariant> values);
 
-  // creates a new chunk and appends it
+  // Inserts rows at the end of the table, given column by column: columns holds one ValueSpan per column, of the
+  // column's data type and all of the same size. The values are copied into the ValueSegments without converting them
+  // one by one. Chunks are filled up to chunk_size() and allocate memory for the rows they will receive.
+  // The rows of one call are contiguous within each chunk, but rows of concurrent calls may be interleaved between
+  // chunks. e.g. table.append_columns({ValueSpan<int32_t>{ids}, ValueSpan<std::string>{names}});
+  void append_columns(const std::vector<AllTypeValueSpan>& columns);
+
+  // Creates a new chunk and appends it. The previous chunk is considered complete and gets its statistics. If auto
+  // compression is enabled, it is encoded in the background.
   void create_new_chunk();
 
-  // compresses a ValueSegment into a DictionarySegment
-  void compress_chunk(ChunkID chunk_id);
+  // compresses the ValueSegments of a chunk, by default into DictionarySegments
+  // spec determines the segment type and, e.g., how the value ids of a DictionarySegment are stored, unless the column
+  // has an encoding of its own (see set_column_encoding). EncodingType::Automatic chooses the encoding per segment.
+  // the compressed chunk keeps the statistics of the uncompressed one, extended by Bloom filters if spec asks for them
+  // Readers of the chunk may run concurrently, they see all of its segments either unencoded or encoded (see
+  // Chunk::segments). Rows may be appended concurrently, too. Chunks that are encoded in the background (see
+  // set_auto_compression) cannot be compressed.
+  void compress_chunk(ChunkID chunk_id, const SegmentEncodingSpec& spec = {});
+
+  // If set, every chunk that is complete (see create_new_chunk) is encoded with spec on a worker of the WorkerPool,
+  // while appends and reads continue. Chunks that were compressed with compress_chunk() are not encoded again.
+  void set_auto_compression(const std::optional<SegmentEncodingSpec>& spec);
+  std::optional<SegmentEncodingSpec> auto_compression() const;
+
+  // Blocks until all chunks that were queued for background encoding are encoded. Rethrows the first exception that
+  // occurred during their encoding.
+  void wait_for_background_compression();
+
+  // Sets the encoding of a column, which takes precedence over the spec of compress_chunk() and of auto compression,
+  // e.g., to keep a column that is scanned often unencoded. nullopt removes the column's encoding.
+  void set_column_encoding(ColumnID column_id, const std::optional<SegmentEncodingSpec>& spec);
+  std::optional<SegmentEncodingSpec> column_encoding(ColumnID column_id) const;
+
+  // Returns the latest encoding decision for every segment that was compressed, ordered by chunk and column
+  std::vector<EncodingDecision> encoding_report() const;
 
  protected:
-  std::vector<std::shared_ptr<Chunk>> _chunks;
+  // creates the statistics of all ValueSegments of a chunk
+  std::vector<std::shared_ptr<BaseSegmentStatistics>> _create_statistics(
+      const Chunk& chunk, const uint32_t bloom_filter_bits_per_value = 0) const;
+
+  // The encoding decisions of the table. The background compressions share it, as they do not refer to the table.
+  struct EncodingLog {
+    std::mutex mutex;
+    std::map<std::pair<ChunkID, ColumnID>, EncodingDecision> decisions;
+  };
+
+  // encodes the ValueSegments of a chunk with spec, or the column's encoding, swaps them in one by one, and logs the
+  // decisions
+  static void _encode_chunk(Chunk& chunk, const ChunkID chunk_id, const std::vector<std::string>& column_types,
+                            const std::vector<std::optional<SegmentEncodingSpec>>& column_encodings,
+                            const SegmentEncodingSpec& spec, EncodingLog& encoding_log);
+
+  // Reserves row_count rows in the last chunks and calls write_rows(chunk, offset, first_row, count) for each chunk,
+  // which writes the rows [first_row, first_row + count) of the input to the rows starting at offset. write_rows must
+  // not throw, as the rows are published afterwards.
+  template <typename RowWriter>
+  void _append_rows(const size_t row_count, const RowWriter& write_rows);
+
+  // Called when no rows could be reserved in chunk: allocates more rows for it or adds a new chunk.
+  // reserved_row_count is the number of rows that were reserved, row_count the number of rows that the writer needs.
+  void _extend_chunks(const std::shared_ptr<Chunk>& chunk, const ChunkOffset reserved_row_count,
+                      const ChunkOffset row_count);
+
+  // creates an empty chunk that rows can be appended to
+  std::shared_ptr<Chunk> _create_appendable_chunk() const;
+
+  // replaces the ValueSegments of a chunk that is appended to by copies that allocate capacity rows
+  void _reallocate_segments(Chunk& chunk, const ChunkOffset capacity) const;
+
+  // stops the appends to a chunk and releases the rows that were allocated, but not written
+  void _close_chunk(Chunk& chunk) const;
+
+  // Closes a chunk that is complete and creates its statistics. If auto compression is enabled, it is encoded in the
+  // background. Has to be called with _append_mutex locked.
+  void _finish_chunk(const std::shared_ptr<Chunk>& chunk);
+
+  // returns the number of rows that a chunk can hold, considering that a chunk size of 0 does not limit the chunks
+  ChunkOffset _max_chunk_row_count() const;
+
+  ChunkList _chunks;
   std::vector<std::string> _column_names;
   std::vector<std::string> _types;
+  std::vector<std::optional<SegmentEncodingSpec>> _column_encodings;
   const uint32_t _chunk_size;
+  std::optional<SegmentEncodingSpec> _auto_compression;
+  std::vector<std::future<void>> _background_compressions;
+  std::set<ChunkID> _background_encoded_chunk_ids;
+  std::shared_ptr<EncodingLog> _encoding_log = std::make_shared<EncodingLog>();
+  // serializes the growth of chunks, adding chunks, the background compressions, and changes of column encodings and
+  // of auto compression
+  mutable std::mutex _append_mutex;
 };
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #include "value_segment.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -10,6 +11,7 @@
 
 #include "type_cast.hpp"
 #include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
 #include "utils/performance_warning.hpp"
 
 namespace opossum {
@@ -22,12 +24,37 @@ const AllTypeVariant ValueSegment<T>::operator[](const size_t offset) const {
 
 template <typename T>
 void ValueSegment<T>::append(const AllTypeVariant& val) {
+  DebugAssert(!_visible_row_count, "Segments that are appended to concurrently are written by Table::append");
   _values.push_back(type_cast<T>(val));
 }
 
+template <typename T>
+void ValueSegment<T>::append_values(const T* values, const size_t count) {
+  DebugAssert(!_visible_row_count, "Segments that are appended to concurrently are written by Table::append");
+  _values.insert(_values.end(), values, values + count);
+}
+
+template <typename T>
+void ValueSegment<T>::reserve(const size_t capacity) {
+  _values.reserve(capacity);
+}
+
+template <typename T>
+void ValueSegment<T>::write_values(const size_t offset, const T* values, const size_t count) {
+  DebugAssert(offset + count <= _values.size(), "Rows have to be allocated before they are written");
+  std::copy(values, values + count, _values.begin() + offset);
+}
+
 template <typename T>
 size_t ValueSegment<T>::size() const {
-  return _values.size();
+  if (!_visible_row_count) return _values.size();
+  // Segments that were replaced by larger ones while the chunk grew keep their size
+  return std::min(size_t{_visible_row_count->load(std::memory_order_acquire)}, _values.size());
+}
+
+template <typename T>
+size_t ValueSegment<T>::estimate_memory_usage() const {
+  return sizeof(*this) + estimate_vector_memory_usage(_values);
 }
 
 template <typename T>
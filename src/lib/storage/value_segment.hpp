@@ -1,37 +1,66 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
+#include "types.hpp"
 
 namespace opossum {
 
-// ValueSegment is a segment type that stores all its values in a vector
+// ValueSegment is a segment type that stores all its values in a vector.
+// The segments of a chunk that a Table appends to concurrently allocate their rows up front and share the chunk's
+// visible row count (see Chunk::reserve_rows). Their size() follows that count, so that readers only see rows that are
+// completely written, while values() also holds the allocated rows behind them.
 template <typename T>
 class ValueSegment : public BaseSegment {
  public:
   // default constructor
   ValueSegment() {}
 
+  // creates a segment that holds the given values
+  explicit ValueSegment(std::vector<T>&& values) : _values(std::move(values)) {}
+
+  // creates a segment of a chunk that is appended to concurrently. values holds the allocated rows, of which the first
+  // visible_row_count are visible.
+  explicit ValueSegment(std::shared_ptr<const std::atomic<ChunkOffset>> visible_row_count,
+                        std::vector<T>&& values = {})
+      : _values(std::move(values)), _visible_row_count(std::move(visible_row_count)) {}
+
   // return the value at a certain position. If you want to write efficient operators, back off!
   const AllTypeVariant operator[](const size_t offset) const override;
 
   // add a value to the end
   void append(const AllTypeVariant& val) override;
 
+  // add count values to the end, without converting them one by one
+  void append_values(const T* values, const size_t count);
+
+  // reserve memory for a total of capacity values
+  void reserve(const size_t capacity);
+
+  // Writes count values to the allocated rows [offset, offset + count) of a segment that is appended to concurrently.
+  // The rows must not be visible yet. Different threads may write different rows at the same time.
+  void write_values(const size_t offset, const T* values, const size_t count);
+
   // return the number of entries
   size_t size() const override;
 
+  // return an estimate of the bytes used, including the rows that are allocated, but not visible yet
+  size_t estimate_memory_usage() const override;
+
   // Return all values. This is the preferred method to check a value at a certain index. Usually you need to
   // access more than a single value anyway.
   // e.g. const auto& values = value_segment.values(); and then: values[i]; in your loop.
+  // If the segment is appended to concurrently, only the first size() values are valid.
   const std::vector<T>& values() const;
 
  protected:
   std::vector<T> _values;
+  std::shared_ptr<const std::atomic<ChunkOffset>> _visible_row_count;
 };
 
 }  // namespace opossum
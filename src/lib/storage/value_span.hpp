@@ -0,0 +1,55 @@
+#pragma once
+
+#include <boost/hana/ext/boost/mpl/vector.hpp>
+#include <boost/hana/transform.hpp>
+#include <boost/variant.hpp>
+
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A read-only view on contiguous values of one column, used to append values in bulk (C++17 has no std::span).
+// The span does not own the values, they have to outlive it.
+template <typename T>
+class ValueSpan {
+ public:
+  ValueSpan(const T* data, const size_t size) : _data(data), _size(size) {}
+  ValueSpan(const std::vector<T>& values) : _data(values.data()), _size(values.size()) {}  // NOLINT - implicit
+
+  const T* data() const { return _data; }
+  size_t size() const { return _size; }
+
+  const T* begin() const { return _data; }
+  const T* end() const { return _data + _size; }
+
+  // returns the span of the values [offset, offset + count)
+  ValueSpan<T> subspan(const size_t offset, const size_t count) const { return ValueSpan<T>{_data + offset, count}; }
+
+ protected:
+  const T* _data;
+  size_t _size;
+};
+
+namespace detail {
+
+struct to_value_span {
+  template <typename Type>
+  constexpr auto operator()(Type) {
+    return hana::type_c<ValueSpan<typename Type::type>>;
+  }
+};
+
+// Equivalent to hana::make_tuple(hana::type_c<ValueSpan<int32_t>>, hana::type_c<ValueSpan<int64_t>>, ...);
+static constexpr auto value_span_types = hana::transform(types, to_value_span{});  // NOLINT
+
+using ValueSpansAsMplVector = decltype(hana::to<hana::ext::boost::mpl::vector_tag>(value_span_types));
+
+}  // namespace detail
+
+// Holds a ValueSpan of any of the data types, so that the columns of a table can be passed in a single vector
+using AllTypeValueSpan = typename boost::make_variant_over<detail::ValueSpansAsMplVector>::type;
+
+}  // namespace opossum
@@ -55,6 +55,13 @@ enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGre
 
 using PosList = std::vector<RowID>;
 
+// Positions that all lie in the chunk chunk_id, e.g., the matches of a scan in one input chunk. They take four bytes
+// per row instead of the eight of a RowID, and readers look up the chunk once instead of once per row.
+struct SingleChunkPosList {
+  ChunkID chunk_id;
+  std::vector<ChunkOffset> chunk_offsets;
+};
+
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
  protected:
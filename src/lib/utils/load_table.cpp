@@ -1,34 +1,298 @@
 #include "load_table.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>  // NOLINT(build/include_order) - unknown to the linter
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/contiguous_string_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/segment_statistics.hpp"
 #include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
 
 namespace opossum {
 
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size) {
-  std::ifstream infile(file_name);
-  Assert(infile.is_open(), "load_table: Could not find file " + file_name);
+namespace {
 
-  std::string line;
-  std::getline(infile, line);
-  std::vector<std::string> column_names = _split<std::string>(line, '|');
-  std::getline(infile, line);
-  std::vector<std::string> column_types = _split<std::string>(line, '|');
+// Ranges of the file that are parsed by one task are at least this large
+constexpr size_t min_bytes_per_range = 64 * 1024;
 
-  std::shared_ptr<Table> test_table = std::make_shared<Table>(chunk_size);
+class BaseColumnParser;
+
+// The values [first, first + count) of a parser
+struct ParsedRows {
+  const BaseColumnParser* parser;
+  size_t first;
+  size_t count;
+};
+
+// Parses the fields of one column into a typed buffer
+class BaseColumnParser {
+ public:
+  virtual ~BaseColumnParser() = default;
+
+  // parses the field [begin, end) and appends its value
+  virtual void parse(const char* begin, const char* end) = 0;
+
+  // returns the number of parsed values
+  virtual size_t size() const = 0;
+
+  // creates a segment that holds the given rows one after another, which come from parsers of the same type
+  virtual std::shared_ptr<BaseSegment> create_segment(const std::vector<ParsedRows>& parts) const = 0;
+};
+
+// Parses the field [begin, end) as a number, accepting the same fields as boost::lexical_cast, including a leading '+'.
+// Integers are parsed by std::from_chars. Standard libraries before libstdc++ 11 and libc++ lack it for floating-point
+// numbers, which are parsed by strtof and strtod instead.
+template <typename T>
+T parse_number(const char* begin, const char* end) {
+  auto value = T{};
+  auto is_valid = begin != end && !std::isspace(static_cast<unsigned char>(*begin));
+  if constexpr (std::is_integral_v<T>) {
+    // std::from_chars does not accept a '+'
+    const auto digits_begin = end - begin > 1 && *begin == '+' && begin[1] != '-' ? begin + 1 : begin;
+    const auto result = std::from_chars(digits_begin, end, value);
+    is_valid = is_valid && result.ec == std::errc() && result.ptr == end;
+  } else if (is_valid) {
+    // strtod needs a terminated string, which short fields keep without allocating
+    const auto field = std::string{begin, end};
+    auto field_end = static_cast<char*>(nullptr);
+    errno = 0;
+    if constexpr (std::is_same_v<T, float>) {
+      value = std::strtof(field.c_str(), &field_end);
+    } else {
+      value = std::strtod(field.c_str(), &field_end);
+    }
+    is_valid = errno == 0 && field_end == field.c_str() + field.size();
+  }
+  Assert(is_valid, "load_table: Could not parse " + std::string(begin, end));
+  return value;
+}
+
+template <typename T>
+class ColumnParser : public BaseColumnParser {
+ public:
+  void parse(const char* begin, const char* end) override { _values.emplace_back(parse_number<T>(begin, end)); }
+
+  size_t size() const override { return _values.size(); }
+
+  std::shared_ptr<BaseSegment> create_segment(const std::vector<ParsedRows>& parts) const override {
+    auto segment = std::make_shared<ValueSegment<T>>();
+    segment->reserve(std::accumulate(parts.cbegin(), parts.cend(), size_t{0},
+                                     [](const auto sum, const auto& part) { return sum + part.count; }));
+    for (const auto& part : parts) {
+      const auto& parser = static_cast<const ColumnParser<T>&>(*part.parser);
+      segment->append_values(parser._values.data() + part.first, part.count);
+    }
+    return segment;
+  }
+
+ protected:
+  std::vector<T> _values;
+};
+
+// Strings are parsed into one buffer of characters and the end offset of every string, which are copied into a
+// ContiguousStringSegment per chunk
+template <>
+class ColumnParser<std::string> : public BaseColumnParser {
+ public:
+  void parse(const char* begin, const char* end) override {
+    _characters.insert(_characters.end(), begin, end);
+    _end_offsets.emplace_back(_characters.size());
+  }
+
+  size_t size() const override { return _end_offsets.size(); }
+
+  std::shared_ptr<BaseSegment> create_segment(const std::vector<ParsedRows>& parts) const override {
+    auto row_count = size_t{0};
+    auto character_count = size_t{0};
+    for (const auto& part : parts) {
+      const auto& parser = static_cast<const ColumnParser<std::string>&>(*part.parser);
+      row_count += part.count;
+      character_count += parser._begin_of(part.first + part.count) - parser._begin_of(part.first);
+    }
+
+    auto characters = std::vector<char>{};
+    auto end_offsets = std::vector<uint64_t>{};
+    characters.reserve(character_count);
+    end_offsets.reserve(row_count);
+    for (const auto& part : parts) {
+      const auto& parser = static_cast<const ColumnParser<std::string>&>(*part.parser);
+      const auto begin = parser._begin_of(part.first);
+      const auto shift = characters.size() - begin;
+      characters.insert(characters.end(), parser._characters.cbegin() + begin,
+                        parser._characters.cbegin() + parser._begin_of(part.first + part.count));
+      for (auto row = part.first; row < part.first + part.count; ++row) {
+        end_offsets.emplace_back(parser._end_offsets[row] + shift);
+      }
+    }
+    return std::make_shared<ContiguousStringSegment>(std::move(characters), std::move(end_offsets));
+  }
+
+ protected:
+  // returns the offset of the first character of a row, or the number of characters for row == size()
+  size_t _begin_of(const size_t row) const { return row == 0 ? 0 : _end_offsets[row - 1]; }
+
+  std::vector<char> _characters;
+  std::vector<uint64_t> _end_offsets;
+};
+
+using ColumnParsers = std::vector<std::unique_ptr<BaseColumnParser>>;
+
+// returns the end of the line that starts at begin, i.e., the position of its '\n' or end
+const char* find_line_end(const char* begin, const char* end) {
+  const auto line_end = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+  return line_end ? line_end : end;
+}
+
+// Parses the lines in [begin, end), which has to start at the beginning of a line
+ColumnParsers parse_range(const char* begin, const char* end, const std::vector<std::string>& column_types) {
+  ColumnParsers parsers;
+  for (const auto& type : column_types) {
+    parsers.emplace_back(make_unique_by_data_type<BaseColumnParser, ColumnParser>(type));
+  }
+
+  for (auto line_begin = begin; line_begin < end;) {
+    const auto line_end = find_line_end(line_begin, end);
+    const auto content_end = line_end > line_begin && *(line_end - 1) == '\r' ? line_end - 1 : line_end;
+
+    // Empty lines, e.g., at the end of the file, are skipped
+    if (content_end != line_begin) {
+      auto field_begin = line_begin;
+      for (size_t column_id = 0; column_id < parsers.size(); ++column_id) {
+        auto field_end = static_cast<const char*>(std::memchr(field_begin, '|', content_end - field_begin));
+        const auto is_last_column = column_id + 1 == parsers.size();
+        Assert(field_end || is_last_column, "load_table: Too few fields in " + std::string(line_begin, content_end));
+        Assert(!field_end || !is_last_column, "load_table: Too many fields in " + std::string(line_begin, content_end));
+        if (!field_end) field_end = content_end;
+
+        parsers[column_id]->parse(field_begin, field_end);
+        field_begin = std::min(field_end + 1, content_end);
+      }
+    }
+    line_begin = line_end + 1;
+  }
+  return parsers;
+}
+
+}  // namespace
+
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size, const LoadTableOptions& options) {
+  const auto file = MappedFile{file_name};
+
+  auto position = file.begin();
+  const auto read_line = [&]() {
+    const auto line_end = find_line_end(position, file.end());
+    auto line = std::string(position, line_end);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    position = std::min(line_end + 1, file.end());
+    return line;
+  };
+  const auto column_names = _split<std::string>(read_line(), '|');
+  const auto column_types = _split<std::string>(read_line(), '|');
+  Assert(column_names.size() == column_types.size(), "load_table: Column names and types do not match");
+
+  auto table = std::make_shared<Table>(chunk_size);
   for (size_t i = 0; i < column_names.size(); i++) {
-    test_table->add_column(column_names[i], column_types[i]);
+    table->add_column(column_names[i], column_types[i]);
+  }
+  if (column_types.empty()) return table;
+
+  const auto max_parallelism =
+      options.max_parallelism == 0 ? WorkerPool::get().worker_count() + 1 : options.max_parallelism;
+
+  // Split the rows into ranges of whole lines, a few more than threads to balance the load
+  const auto byte_count = static_cast<size_t>(file.end() - position);
+  const auto range_count = std::clamp(byte_count / min_bytes_per_range, size_t{1}, max_parallelism * 4);
+  std::vector<const char*> range_begins{position};
+  for (size_t range_index = 1; range_index < range_count; ++range_index) {
+    const auto split_position = position + byte_count * range_index / range_count;
+    const auto range_begin = std::min(find_line_end(split_position - 1, file.end()) + 1, file.end());
+    range_begins.emplace_back(std::max(range_begin, range_begins.back()));
+  }
+  range_begins.emplace_back(file.end());
+
+  std::vector<ColumnParsers> ranges(range_count);
+  std::vector<std::function<void()>> parse_tasks;
+  for (size_t range_index = 0; range_index < range_count; ++range_index) {
+    parse_tasks.emplace_back([&, range_index]() {
+      ranges[range_index] = parse_range(range_begins[range_index], range_begins[range_index + 1], column_types);
+    });
+  }
+  WorkerPool::get().execute_tasks(parse_tasks, max_parallelism);
+
+  // range_first_rows[i] is the index of the first row of range i in the table
+  std::vector<size_t> range_first_rows{0};
+  for (const auto& parsers : ranges) {
+    range_first_rows.emplace_back(range_first_rows.back() + parsers[0]->size());
+  }
+  const auto row_count = range_first_rows.back();
+
+  // A chunk size of 0 does not limit the chunk
+  const auto rows_per_chunk = chunk_size == 0 ? std::max(row_count, size_t{1}) : chunk_size;
+  const auto chunk_count = (row_count + rows_per_chunk - 1) / rows_per_chunk;
+
+  // Every chunk copies its rows from the ranges that overlap with it, then encodes them if it is full
+  std::vector<Chunk> chunks(chunk_count);
+  std::vector<std::function<void()>> chunk_tasks;
+  for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+    chunk_tasks.emplace_back([&, chunk_index]() {
+      const auto first_row = chunk_index * rows_per_chunk;
+      const auto end_row = std::min(first_row + rows_per_chunk, row_count);
+
+      auto& chunk = chunks[chunk_index];
+      for (ColumnID column_id{0}; column_id < column_types.size(); ++column_id) {
+        auto parts = std::vector<ParsedRows>{};
+        const auto first_range = std::upper_bound(range_first_rows.cbegin(), range_first_rows.cend(), first_row) - 1;
+        auto range_index = static_cast<size_t>(first_range - range_first_rows.cbegin());
+        for (auto row = first_row; row < end_row; ++range_index) {
+          const auto count = std::min(end_row, range_first_rows[range_index + 1]) - row;
+          parts.push_back({ranges[range_index][column_id].get(), row - range_first_rows[range_index], count});
+          row += count;
+        }
+        chunk.add_segment(ranges[0][column_id]->create_segment(parts));
+      }
+
+      if (chunk.size() != chunk_size) return;
+
+      const auto bloom_filter_bits_per_value =
+          options.chunk_encoding ? options.chunk_encoding->bloom_filter_bits_per_value : 0;
+      std::vector<std::shared_ptr<BaseSegmentStatistics>> statistics;
+      for (ColumnID column_id{0}; column_id < column_types.size(); ++column_id) {
+        statistics.emplace_back(create_segment_statistics(column_types[column_id], chunk.get_segment(column_id),
+                                                          bloom_filter_bits_per_value));
+      }
+
+      if (options.chunk_encoding) {
+        auto encoded_chunk = Chunk{};
+        for (ColumnID column_id{0}; column_id < column_types.size(); ++column_id) {
+          encoded_chunk.add_segment(
+              encode_segment(column_types[column_id], chunk.get_segment(column_id), *options.chunk_encoding));
+        }
+        chunk = std::move(encoded_chunk);
+      }
+      chunk.set_statistics(std::move(statistics));
+    });
   }
+  WorkerPool::get().execute_tasks(chunk_tasks, max_parallelism);
 
-  while (std::getline(infile, line)) {
-    std::vector<AllTypeVariant> values = _split<AllTypeVariant>(line, '|');
-    test_table->append(values);
+  for (auto& chunk : chunks) {
+    table->emplace_chunk(std::move(chunk));
   }
-  return test_table;
+  return table;
 }
 
 }  // namespace opossum
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "storage/encoding_type.hpp"
+
 namespace opossum {
 
 class Table;
@@ -22,7 +25,19 @@ std::vector<T> _split(const std::string& str, char delimiter) {
   return internal;
 }
 
+struct LoadTableOptions {
+  // if set, every full chunk is encoded with this spec as soon as it has been assembled
+  std::optional<SegmentEncodingSpec> chunk_encoding;
+  // limits the number of threads that parse the file and assemble chunks, 0 uses all workers of the WorkerPool
+  size_t max_parallelism = 0;
+};
+
+// Loads a table from a .tbl file: The first two lines hold the column names and types, the following lines one row
+// each, all fields are separated by '|'. The file is memory-mapped and split into ranges of whole lines, which are
+// parsed in parallel into typed buffers. The chunks are then assembled in parallel, too. String columns are stored as
+// ContiguousStringSegments, so that no string is allocated on its own.
 // This is a helper method which is heavily used in our test suite
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size);
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size,
+                                  const LoadTableOptions& options = {});
 
 }  // namespace opossum
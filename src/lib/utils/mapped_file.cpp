@@ -0,0 +1,29 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MappedFile::MappedFile(const std::string& file_name) : _data(MAP_FAILED) {
+  const auto file_descriptor = open(file_name.c_str(), O_RDONLY);
+  Assert(file_descriptor != -1, "Could not find file " + file_name);
+
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0) {
+    _size = static_cast<size_t>(file_status.st_size);
+    _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  }
+  close(file_descriptor);
+  Assert(_data != MAP_FAILED, "Could not map file " + file_name);
+}
+
+MappedFile::~MappedFile() { munmap(_data, _size); }
+
+}  // namespace opossum
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// Maps a file read-only into memory for the lifetime of the object
+class MappedFile : private Noncopyable {
+ public:
+  explicit MappedFile(const std::string& file_name);
+  ~MappedFile();
+
+  const char* begin() const { return static_cast<const char*>(_data); }
+  const char* end() const { return begin() + _size; }
+  size_t size() const { return _size; }
+
+ protected:
+  void* _data;
+  size_t _size = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace opossum {
+
+// Estimates the number of bytes that a vector has allocated. For strings, this includes the characters that do not fit
+// into the string object itself (small string optimization) and are stored on the heap.
+template <typename T>
+size_t estimate_vector_memory_usage(const std::vector<T>& values) {
+  auto bytes = values.capacity() * sizeof(T);
+  if constexpr (std::is_same<T, std::string>::value) {
+    const auto inline_capacity = std::string{}.capacity();
+    for (const auto& value : values) {
+      if (value.capacity() > inline_capacity) bytes += value.capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+}  // namespace opossum
@@ -0,0 +1,506 @@
+#include "table_snapshot.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/bit_packed_attribute_vector.hpp"
+#include "storage/contiguous_string_segment.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fitted_attribute_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/front_coded_dictionary_segment.hpp"
+#include "storage/gorilla_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/segment_statistics.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/value_span.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr char snapshot_magic[8] = {'O', 'P', 'O', 'S', 'S', 'U', 'M', 'S'};
+constexpr uint64_t snapshot_version = 1;
+constexpr size_t blob_alignment = 64;
+// The trailer holds the position and size of the footer, followed by the magic number
+constexpr size_t trailer_size = 2 * sizeof(uint64_t) + sizeof(snapshot_magic);
+
+enum class SegmentTag : uint64_t { Value, Dictionary, RunLength, FrameOfReference, Gorilla, FrontCodedDictionary };
+enum class AttributeVectorTag : uint64_t { Fitted8, Fitted16, Fitted32, BitPacked };
+
+// Writes the blobs to the file while it collects the footer, which is written by finish()
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(const std::string& file_name) : _file(file_name, std::ios::binary | std::ios::trunc) {
+    Assert(_file.is_open(), "Could not create snapshot " + file_name);
+    _write(snapshot_magic, sizeof(snapshot_magic));
+    _write(&snapshot_version, sizeof(snapshot_version));
+  }
+
+  // appends a number to the footer
+  void put(const uint64_t value) {
+    const auto bytes = reinterpret_cast<const char*>(&value);
+    _footer.insert(_footer.end(), bytes, bytes + sizeof(value));
+  }
+
+  // appends a value of a column to the footer
+  template <typename T>
+  void put_value(const T& value) {
+    if constexpr (std::is_same<T, std::string>::value) {
+      put(value.size());
+      _footer.insert(_footer.end(), value.cbegin(), value.cend());
+    } else {
+      auto bits = uint64_t{0};
+      std::memcpy(&bits, &value, sizeof(T));
+      put(bits);
+    }
+  }
+
+  // writes an aligned blob and appends its position and size to the footer
+  void write_blob(const void* data, const size_t byte_count) {
+    _pad();
+    put(_offset);
+    put(byte_count);
+    _write(data, byte_count);
+  }
+
+  // Writes a vector of values. Strings are written as two blobs: the end offsets of the strings and their characters.
+  template <typename T>
+  void write_values(const std::vector<T>& values) {
+    write_values(ValueSpan<T>{values});
+  }
+
+  template <typename T>
+  void write_values(const ValueSpan<T>& values) {
+    put(values.size());
+    if constexpr (std::is_same<T, std::string>::value) {
+      auto end_offsets = std::vector<uint64_t>{};
+      auto characters = std::string{};
+      end_offsets.reserve(values.size());
+      for (const auto& value : values) {
+        characters += value;
+        end_offsets.emplace_back(characters.size());
+      }
+      write_blob(end_offsets.data(), end_offsets.size() * sizeof(uint64_t));
+      write_blob(characters.data(), characters.size());
+    } else {
+      write_blob(values.data(), values.size() * sizeof(T));
+    }
+  }
+
+  // writes the footer and the trailer
+  void finish() {
+    _pad();
+    const auto footer_offset = _offset;
+    _write(_footer.data(), _footer.size());
+    const auto footer_size = uint64_t{_footer.size()};
+    _write(&footer_offset, sizeof(footer_offset));
+    _write(&footer_size, sizeof(footer_size));
+    _write(snapshot_magic, sizeof(snapshot_magic));
+
+    _file.flush();
+    Assert(_file.good(), "Could not write snapshot");
+  }
+
+ protected:
+  void _write(const void* data, const size_t byte_count) {
+    _file.write(static_cast<const char*>(data), byte_count);
+    _offset += byte_count;
+  }
+
+  void _pad() {
+    static constexpr char zeros[blob_alignment] = {};
+    _write(zeros, (blob_alignment - _offset % blob_alignment) % blob_alignment);
+  }
+
+  std::ofstream _file;
+  uint64_t _offset = 0;
+  std::vector<char> _footer;
+};
+
+// Reads the footer front to back and hands out the blobs it refers to
+class SnapshotReader {
+ public:
+  explicit SnapshotReader(const std::string& file_name) : _file(std::make_shared<const MappedFile>(file_name)) {
+    const auto begin = _file->begin();
+    const auto size = _file->size();
+    Assert(size >= blob_alignment + trailer_size && std::memcmp(begin, snapshot_magic, sizeof(snapshot_magic)) == 0 &&
+               std::memcmp(_file->end() - sizeof(snapshot_magic), snapshot_magic, sizeof(snapshot_magic)) == 0,
+           file_name + " is not a snapshot");
+
+    auto version = uint64_t{0};
+    std::memcpy(&version, begin + sizeof(snapshot_magic), sizeof(version));
+    Assert(version == snapshot_version, "Snapshot version " + std::to_string(version) + " is not supported");
+
+    auto footer_offset = uint64_t{0};
+    auto footer_size = uint64_t{0};
+    std::memcpy(&footer_offset, _file->end() - trailer_size, sizeof(footer_offset));
+    std::memcpy(&footer_size, _file->end() - trailer_size + sizeof(footer_offset), sizeof(footer_size));
+    Assert(footer_offset + footer_size == size - trailer_size, "The footer of " + file_name + " is corrupt");
+
+    _position = begin + footer_offset;
+    _footer_end = _position + footer_size;
+  }
+
+  // reads a number from the footer
+  uint64_t get() {
+    Assert(_position + sizeof(uint64_t) <= _footer_end, "Unexpected end of the snapshot footer");
+    auto value = uint64_t{0};
+    std::memcpy(&value, _position, sizeof(value));
+    _position += sizeof(value);
+    return value;
+  }
+
+  // reads a value of a column from the footer
+  template <typename T>
+  T get_value() {
+    if constexpr (std::is_same<T, std::string>::value) {
+      const auto size = get();
+      Assert(size <= static_cast<size_t>(_footer_end - _position), "Unexpected end of the snapshot footer");
+      auto value = std::string(_position, size);
+      _position += size;
+      return value;
+    } else {
+      const auto bits = get();
+      auto value = T{};
+      std::memcpy(&value, &bits, sizeof(T));
+      return value;
+    }
+  }
+
+  // returns the next blob, which has to hold count values of type T
+  template <typename T>
+  const T* get_blob(const size_t count) {
+    const auto offset = get();
+    const auto byte_count = get();
+    Assert(offset % blob_alignment == 0 && byte_count == count * sizeof(T) &&
+               offset + byte_count <= static_cast<size_t>(_footer_end - _file->begin()),
+           "The snapshot refers to an invalid blob");
+    return reinterpret_cast<const T*>(_file->begin() + offset);
+  }
+
+  // reads a vector of values that was written by SnapshotWriter::write_values()
+  template <typename T>
+  std::vector<T> get_values() {
+    const auto count = get();
+    if constexpr (std::is_same<T, std::string>::value) {
+      const auto end_offsets = get_blob<uint64_t>(count);
+      const auto characters = get_blob<char>(count == 0 ? 0 : end_offsets[count - 1]);
+      auto values = std::vector<std::string>{};
+      values.reserve(count);
+      for (size_t index = 0; index < count; ++index) {
+        const auto begin = index == 0 ? uint64_t{0} : end_offsets[index - 1];
+        values.emplace_back(characters + begin, end_offsets[index] - begin);
+      }
+      return values;
+    } else {
+      const auto data = get_blob<T>(count);
+      return std::vector<T>(data, data + count);
+    }
+  }
+
+  // returns the mapped file, e.g., to keep it alive as long as segments point into it
+  const std::shared_ptr<const MappedFile>& file() const { return _file; }
+
+ protected:
+  std::shared_ptr<const MappedFile> _file;
+  const char* _position;
+  const char* _footer_end;
+};
+
+void write_bit_packed_vector(SnapshotWriter& writer, const BitPackedVector& vector) {
+  writer.put(vector.size());
+  writer.put(vector.bit_width());
+  writer.write_blob(vector.words(), vector.word_count() * sizeof(uint64_t));
+}
+
+std::shared_ptr<BitPackedVector> read_bit_packed_vector(SnapshotReader& reader) {
+  const auto size = reader.get();
+  const auto bit_width = static_cast<uint8_t>(reader.get());
+  Assert(bit_width >= 1 && bit_width <= 64, "The snapshot contains an invalid bit width");
+  const auto words = reader.get_blob<uint64_t>((size * bit_width + 63) / 64);
+  return std::make_shared<BitPackedVector>(size, bit_width, words, reader.file());
+}
+
+// Writes the attribute vector if it is a FittedAttributeVector<Code>. Returns false otherwise.
+template <typename Code>
+bool write_fitted_attribute_vector(SnapshotWriter& writer, const BaseAttributeVector& attribute_vector,
+                                   const AttributeVectorTag tag) {
+  const auto fitted_attribute_vector = dynamic_cast<const FittedAttributeVector<Code>*>(&attribute_vector);
+  if (!fitted_attribute_vector) return false;
+
+  writer.put(static_cast<uint64_t>(tag));
+  writer.put(fitted_attribute_vector->size());
+  writer.write_blob(fitted_attribute_vector->data(), fitted_attribute_vector->size() * sizeof(Code));
+  return true;
+}
+
+void write_attribute_vector(SnapshotWriter& writer, const BaseAttributeVector& attribute_vector) {
+  if (write_fitted_attribute_vector<uint8_t>(writer, attribute_vector, AttributeVectorTag::Fitted8) ||
+      write_fitted_attribute_vector<uint16_t>(writer, attribute_vector, AttributeVectorTag::Fitted16) ||
+      write_fitted_attribute_vector<uint32_t>(writer, attribute_vector, AttributeVectorTag::Fitted32)) {
+    return;
+  }
+
+  const auto bit_packed_attribute_vector = dynamic_cast<const BitPackedAttributeVector*>(&attribute_vector);
+  Assert(bit_packed_attribute_vector, "Attribute vector type is not supported by snapshots");
+  writer.put(static_cast<uint64_t>(AttributeVectorTag::BitPacked));
+  write_bit_packed_vector(writer, *bit_packed_attribute_vector->values());
+}
+
+template <typename Code>
+std::shared_ptr<BaseAttributeVector> read_fitted_attribute_vector(SnapshotReader& reader) {
+  const auto size = reader.get();
+  return std::make_shared<FittedAttributeVector<Code>>(reader.get_blob<Code>(size), size, reader.file());
+}
+
+std::shared_ptr<BaseAttributeVector> read_attribute_vector(SnapshotReader& reader) {
+  switch (static_cast<AttributeVectorTag>(reader.get())) {
+    case AttributeVectorTag::Fitted8:
+      return read_fitted_attribute_vector<uint8_t>(reader);
+    case AttributeVectorTag::Fitted16:
+      return read_fitted_attribute_vector<uint16_t>(reader);
+    case AttributeVectorTag::Fitted32:
+      return read_fitted_attribute_vector<uint32_t>(reader);
+    case AttributeVectorTag::BitPacked:
+      return std::make_shared<BitPackedAttributeVector>(read_bit_packed_vector(reader));
+  }
+  Fail("The snapshot contains an invalid attribute vector");
+  return nullptr;
+}
+
+template <typename T>
+void write_segment(SnapshotWriter& writer, const std::shared_ptr<BaseSegment>& segment) {
+  if constexpr (std::is_same<T, std::string>::value) {
+    // The layout of the strings is the one of write_values(), so they are loaded as a ContiguousStringSegment, too
+    if (const auto string_segment = std::dynamic_pointer_cast<const ContiguousStringSegment>(segment)) {
+      writer.put(static_cast<uint64_t>(SegmentTag::Value));
+      writer.put(string_segment->size());
+      writer.write_blob(string_segment->end_offsets(), string_segment->size() * sizeof(uint64_t));
+      writer.write_blob(string_segment->characters(), string_segment->character_count());
+      return;
+    }
+
+    if (const auto dictionary_segment = std::dynamic_pointer_cast<const FrontCodedDictionarySegment>(segment)) {
+      const auto& dictionary = *dictionary_segment->dictionary();
+      writer.put(static_cast<uint64_t>(SegmentTag::FrontCodedDictionary));
+      writer.put(dictionary.size());
+      writer.put(dictionary.data_size());
+      writer.write_blob(dictionary.block_offsets(), dictionary.block_count() * sizeof(uint64_t));
+      writer.write_blob(dictionary.data(), dictionary.data_size());
+      write_attribute_vector(writer, *dictionary_segment->attribute_vector());
+      return;
+    }
+  }
+
+  if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(segment)) {
+    writer.put(static_cast<uint64_t>(SegmentTag::Value));
+    // The segments of a chunk that is appended to hold more rows than are visible
+    writer.write_values(ValueSpan<T>{value_segment->values().data(), value_segment->size()});
+    return;
+  }
+
+  if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+    writer.put(static_cast<uint64_t>(SegmentTag::Dictionary));
+    writer.write_values(*dictionary_segment->dictionary());
+    write_attribute_vector(writer, *dictionary_segment->attribute_vector());
+    return;
+  }
+
+  if (const auto run_length_segment = std::dynamic_pointer_cast<const RunLengthSegment<T>>(segment)) {
+    writer.put(static_cast<uint64_t>(SegmentTag::RunLength));
+    writer.write_values(*run_length_segment->values());
+    writer.write_values(*run_length_segment->end_positions());
+    return;
+  }
+
+  if constexpr (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+    if (const auto frame_of_reference_segment = std::dynamic_pointer_cast<const FrameOfReferenceSegment<T>>(segment)) {
+      writer.put(static_cast<uint64_t>(SegmentTag::FrameOfReference));
+      writer.put(frame_of_reference_segment->is_delta());
+      writer.write_values(*frame_of_reference_segment->block_minimums());
+      write_bit_packed_vector(writer, *frame_of_reference_segment->offsets());
+      return;
+    }
+  }
+
+  if constexpr (std::is_floating_point<T>::value) {
+    if (const auto gorilla_segment = std::dynamic_pointer_cast<const GorillaSegment<T>>(segment)) {
+      writer.put(static_cast<uint64_t>(SegmentTag::Gorilla));
+      writer.put(gorilla_segment->size());
+      writer.write_values(*gorilla_segment->words());
+      writer.write_values(*gorilla_segment->block_bit_offsets());
+      return;
+    }
+  }
+
+  Fail("Segment type is not supported by snapshots");
+}
+
+template <typename T>
+std::shared_ptr<BaseSegment> read_segment(SnapshotReader& reader) {
+  switch (static_cast<SegmentTag>(reader.get())) {
+    case SegmentTag::Value:
+      if constexpr (std::is_same<T, std::string>::value) {
+        // Strings are not copied out of the mapped file
+        const auto count = reader.get();
+        const auto end_offsets = reader.get_blob<uint64_t>(count);
+        const auto characters = reader.get_blob<char>(count == 0 ? 0 : end_offsets[count - 1]);
+        return std::make_shared<ContiguousStringSegment>(characters, end_offsets, count, reader.file());
+      }
+      return std::make_shared<ValueSegment<T>>(reader.get_values<T>());
+
+    case SegmentTag::Dictionary: {
+      auto dictionary = std::make_shared<std::vector<T>>(reader.get_values<T>());
+      return std::make_shared<DictionarySegment<T>>(std::move(dictionary), read_attribute_vector(reader));
+    }
+
+    case SegmentTag::RunLength: {
+      auto values = std::make_shared<std::vector<T>>(reader.get_values<T>());
+      auto end_positions = std::make_shared<std::vector<ChunkOffset>>(reader.get_values<ChunkOffset>());
+      return std::make_shared<RunLengthSegment<T>>(std::move(values), std::move(end_positions));
+    }
+
+    case SegmentTag::FrameOfReference:
+      if constexpr (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+        const auto is_delta = reader.get() != 0;
+        auto block_minimums = std::make_shared<std::vector<T>>(reader.get_values<T>());
+        return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minimums), read_bit_packed_vector(reader),
+                                                            is_delta);
+      }
+      break;
+
+    case SegmentTag::Gorilla:
+      if constexpr (std::is_floating_point<T>::value) {
+        const auto size = reader.get();
+        auto words = std::make_shared<std::vector<uint64_t>>(reader.get_values<uint64_t>());
+        auto block_bit_offsets = std::make_shared<std::vector<size_t>>(reader.get_values<size_t>());
+        return std::make_shared<GorillaSegment<T>>(std::move(words), std::move(block_bit_offsets), size);
+      }
+      break;
+
+    case SegmentTag::FrontCodedDictionary:
+      if constexpr (std::is_same<T, std::string>::value) {
+        // The dictionary is not copied out of the mapped file
+        const auto size = reader.get();
+        const auto data_size = reader.get();
+        const auto block_count = (size + FrontCodedDictionary::block_size - 1) / FrontCodedDictionary::block_size;
+        const auto block_offsets = reader.get_blob<uint64_t>(block_count);
+        const auto data = reader.get_blob<char>(data_size);
+        auto dictionary = std::make_shared<FrontCodedDictionary>(data, data_size, block_offsets, size, reader.file());
+        return std::make_shared<FrontCodedDictionarySegment>(std::move(dictionary), read_attribute_vector(reader));
+      }
+      break;
+  }
+  Fail("The snapshot contains an invalid segment");
+  return nullptr;
+}
+
+template <typename T>
+void write_statistics(SnapshotWriter& writer, const BaseSegmentStatistics& base_statistics) {
+  const auto& statistics = static_cast<const SegmentStatistics<T>&>(base_statistics);
+  writer.put(statistics.row_count());
+  writer.put(statistics.has_min_max());
+  writer.put(statistics.contains_nan());
+  writer.put_value(statistics.min());
+  writer.put_value(statistics.max());
+
+  const auto bloom_filter = statistics.bloom_filter();
+  writer.put(bloom_filter != nullptr);
+  if (bloom_filter) {
+    writer.put(bloom_filter->hash_count());
+    writer.put(bloom_filter->bit_count() / 64);
+    writer.write_blob(bloom_filter->words(), bloom_filter->bit_count() / 8);
+  }
+}
+
+template <typename T>
+std::shared_ptr<BaseSegmentStatistics> read_statistics(SnapshotReader& reader) {
+  const auto row_count = reader.get();
+  const auto has_min_max = reader.get() != 0;
+  const auto contains_nan = reader.get() != 0;
+  const auto min = reader.get_value<T>();
+  const auto max = reader.get_value<T>();
+
+  auto bloom_filter = std::shared_ptr<BloomFilter>{};
+  if (reader.get() != 0) {
+    const auto hash_count = static_cast<uint32_t>(reader.get());
+    const auto word_count = reader.get();
+    bloom_filter = std::make_shared<BloomFilter>(reader.get_blob<uint64_t>(word_count), word_count, hash_count);
+  }
+  return std::make_shared<SegmentStatistics<T>>(row_count, min, max, has_min_max, contains_nan,
+                                                std::move(bloom_filter));
+}
+
+}  // namespace
+
+void write_table_snapshot(const Table& table, const std::string& file_name) {
+  auto writer = SnapshotWriter{file_name};
+
+  writer.put(table.chunk_size());
+  writer.put(table.column_count());
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+    writer.put_value(table.column_name(column_id));
+    writer.put_value(table.column_type(column_id));
+  }
+
+  writer.put(table.chunk_count());
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    const auto has_statistics = chunk.column_count() > 0 && chunk.get_statistics(ColumnID{0}) != nullptr;
+    writer.put(has_statistics);
+
+    for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        write_segment<ColumnDataType>(writer, chunk.get_segment(column_id));
+        if (has_statistics) write_statistics<ColumnDataType>(writer, *chunk.get_statistics(column_id));
+      });
+    }
+  }
+
+  writer.finish();
+}
+
+std::shared_ptr<Table> load_table_snapshot(const std::string& file_name) {
+  auto reader = SnapshotReader{file_name};
+
+  const auto chunk_size = static_cast<uint32_t>(reader.get());
+  const auto column_count = reader.get();
+  auto table = std::make_shared<Table>(chunk_size);
+  auto column_types = std::vector<std::string>{};
+  for (size_t column_id = 0; column_id < column_count; ++column_id) {
+    const auto column_name = reader.get_value<std::string>();
+    column_types.emplace_back(reader.get_value<std::string>());
+    table->add_column_definition(column_name, column_types.back());
+  }
+
+  const auto chunk_count = reader.get();
+  for (size_t chunk_id = 0; chunk_id < chunk_count; ++chunk_id) {
+    const auto has_statistics = reader.get() != 0;
+    auto chunk = Chunk{};
+    auto statistics = std::vector<std::shared_ptr<BaseSegmentStatistics>>{};
+    for (const auto& column_type : column_types) {
+      resolve_data_type(column_type, [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        chunk.add_segment(read_segment<ColumnDataType>(reader));
+        if (has_statistics) statistics.emplace_back(read_statistics<ColumnDataType>(reader));
+      });
+    }
+    if (has_statistics) chunk.set_statistics(std::move(statistics));
+    table->emplace_chunk(std::move(chunk));
+  }
+
+  return table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Snapshots store tables in a binary format, so that they can be loaded without parsing and encoding them again.
+ *
+ * A snapshot starts with a header that holds a magic number and the format version. It is followed by blobs, one per
+ * vector of a segment (e.g., the values of a ValueSegment, or the dictionary and the attribute vector of a
+ * DictionarySegment), which start at multiples of 64 bytes. A footer describes the columns, chunks, segments, and
+ * statistics and refers to the blobs by their position. The last bytes locate the footer.
+ */
+
+// Writes the table with all of its segments as they are encoded, and the statistics of its chunks.
+// Tables that contain ReferenceSegments cannot be written.
+void write_table_snapshot(const Table& table, const std::string& file_name);
+
+// Loads a table from a snapshot. The file is memory-mapped and attribute vectors, the bit-packed offsets of
+// FrameOfReferenceSegments, front-coded dictionaries, and unencoded strings, which become ContiguousStringSegments,
+// are used without copying them. The mapping is released once no segment refers to it anymore. All other vectors are
+// copied from the mapping.
+std::shared_ptr<Table> load_table_snapshot(const std::string& file_name);
+
+}  // namespace opossum
@@ -6,6 +6,8 @@
 #include <utility>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "type_cast.hpp"
@@ -43,11 +45,13 @@ BaseTest::Matrix BaseTest::_table_to_matrix(const Table& table) {
     if (chunk.size() == 0) continue;
 
     for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
-      std::shared_ptr<BaseSegment> segment = chunk.get_segment(column_id);
-
-      for (ChunkOffset chunk_offset = 0; chunk_offset < chunk.size(); ++chunk_offset) {
-        matrix[row_offset + chunk_offset][column_id] = (*segment)[chunk_offset];
-      }
+      resolve_data_type(table.column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto row = row_offset;
+        segment_iterate<ColumnDataType>(*chunk.get_segment(column_id), [&](const auto& value) {
+          matrix[row++][column_id] = ColumnDataType{value};
+        });
+      });
     }
     row_offset += chunk.size();
   }
@@ -0,0 +1,171 @@
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/operators/scan_kernels.hpp"
+#include "../lib/resolve_type.hpp"
+
+namespace opossum {
+
+class OperatorsScanKernelsTest : public BaseTest {
+ protected:
+  template <typename T>
+  static bool matches(const ScanType scan_type, const T& value, const T& search_value) {
+    return (scan_type == ScanType::OpEquals && value == search_value) ||
+           (scan_type == ScanType::OpNotEquals && value != search_value) ||
+           (scan_type == ScanType::OpLessThan && value < search_value) ||
+           (scan_type == ScanType::OpLessThanEquals && value <= search_value) ||
+           (scan_type == ScanType::OpGreaterThan && value > search_value) ||
+           (scan_type == ScanType::OpGreaterThanEquals && value >= search_value);
+  }
+
+  // Compares the kernel's result with a straightforward scalar scan for all scan types
+  template <typename T>
+  void check_all_scan_types(const std::vector<T>& values, const T& search_value) {
+    for (const auto scan_type : all_scan_types) {
+      auto expected_pos_list = PosList{};
+      for (ChunkOffset chunk_offset = 0; chunk_offset < values.size(); ++chunk_offset) {
+        if (matches(scan_type, values[chunk_offset], search_value)) {
+          expected_pos_list.emplace_back(RowID{ChunkID{3}, chunk_offset + 10});
+        }
+      }
+
+      auto pos_list = PosList{};
+      resolve_scan_type(scan_type, [&](auto type) {
+        scan_values<decltype(type)::value>(values.data(), values.size(), search_value, ChunkID{3}, ChunkOffset{10},
+                                           pos_list);
+      });
+      EXPECT_EQ(pos_list, expected_pos_list) << "scan type " << static_cast<int>(scan_type);
+    }
+  }
+
+  template <typename Code>
+  void check_value_id_scan_types(const std::vector<Code>& codes, const Code search_code) {
+    for (const auto scan_type : all_scan_types) {
+      auto expected_pos_list = PosList{};
+      for (ChunkOffset chunk_offset = 0; chunk_offset < codes.size(); ++chunk_offset) {
+        if (matches(scan_type, codes[chunk_offset], search_code)) {
+          expected_pos_list.emplace_back(RowID{ChunkID{1}, chunk_offset});
+        }
+      }
+
+      auto pos_list = PosList{};
+      resolve_scan_type(scan_type, [&](auto type) {
+        scan_value_ids<decltype(type)::value>(codes.data(), codes.size(), search_code, ChunkID{1}, ChunkOffset{0},
+                                              pos_list);
+      });
+      EXPECT_EQ(pos_list, expected_pos_list) << "scan type " << static_cast<int>(scan_type);
+    }
+  }
+
+  const std::vector<ScanType> all_scan_types{ScanType::OpEquals,      ScanType::OpNotEquals,
+                                             ScanType::OpLessThan,    ScanType::OpLessThanEquals,
+                                             ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals};
+};
+
+TEST_F(OperatorsScanKernelsTest, ValueIDs) {
+  // Codes above the signed maximum of each width make sure that the comparisons are unsigned
+  auto codes_8 = std::vector<uint8_t>{};
+  auto codes_16 = std::vector<uint16_t>{};
+  auto codes_32 = std::vector<uint32_t>{};
+  for (uint32_t index = 0; index < 101; ++index) {
+    codes_8.emplace_back(static_cast<uint8_t>(index * 37));
+    codes_16.emplace_back(static_cast<uint16_t>(index * 4099));
+    codes_32.emplace_back(index * 87654321u);
+  }
+
+  check_value_id_scan_types<uint8_t>(codes_8, 0);
+  check_value_id_scan_types<uint8_t>(codes_8, 200);
+  check_value_id_scan_types<uint16_t>(codes_16, 40000);
+  check_value_id_scan_types<uint16_t>(codes_16, 3);
+  check_value_id_scan_types<uint32_t>(codes_32, 3000000000u);
+  check_value_id_scan_types<uint32_t>(codes_32, 87654321u);
+
+  // The SIMD comparisons are emulated with min and max, which must also work for the extreme codes
+  check_value_id_scan_types<uint8_t>(codes_8, std::numeric_limits<uint8_t>::max());
+  check_value_id_scan_types<uint16_t>(codes_16, 0);
+  check_value_id_scan_types<uint16_t>(codes_16, std::numeric_limits<uint16_t>::max());
+  check_value_id_scan_types<uint32_t>(codes_32, 0);
+  check_value_id_scan_types<uint32_t>(codes_32, std::numeric_limits<uint32_t>::max());
+}
+
+TEST_F(OperatorsScanKernelsTest, Int) {
+  // 37 values do not fill the last SIMD block, so the scalar tail is covered as well
+  auto values = std::vector<int32_t>{};
+  for (int32_t value = 0; value < 37; ++value) values.emplace_back((value * 7) % 11 - 5);
+  values.emplace_back(std::numeric_limits<int32_t>::min());
+  values.emplace_back(std::numeric_limits<int32_t>::max());
+
+  check_all_scan_types<int32_t>(values, 0);
+  check_all_scan_types<int32_t>(values, -5);
+  check_all_scan_types<int32_t>(values, std::numeric_limits<int32_t>::max());
+}
+
+TEST_F(OperatorsScanKernelsTest, Long) {
+  auto values = std::vector<int64_t>{};
+  for (int64_t value = 0; value < 23; ++value) values.emplace_back((value * 5) % 9 * (int64_t{1} << 40));
+  values.emplace_back(std::numeric_limits<int64_t>::min());
+
+  check_all_scan_types<int64_t>(values, int64_t{4} << 40);
+  check_all_scan_types<int64_t>(values, -1);
+}
+
+TEST_F(OperatorsScanKernelsTest, FloatingPoint) {
+  auto float_values = std::vector<float>{};
+  auto double_values = std::vector<double>{};
+  for (int32_t value = 0; value < 29; ++value) {
+    float_values.emplace_back(static_cast<float>(value % 6) * 0.5f);
+    double_values.emplace_back(static_cast<double>(value % 6) * 0.5);
+  }
+  // NaN only matches OpNotEquals
+  float_values[4] = std::nanf("");
+  double_values[4] = std::nan("");
+
+  check_all_scan_types<float>(float_values, 1.0f);
+  check_all_scan_types<float>(float_values, 1.2f);
+  check_all_scan_types<double>(double_values, 1.0);
+  check_all_scan_types<double>(double_values, -0.5);
+}
+
+TEST_F(OperatorsScanKernelsTest, SimdComparator) {
+  // hyriseScanKernelsAvx2Test and hyriseScanKernelsSse42Test build this file for the respective instruction set
+#if defined(__AVX2__) || defined(__SSE4_2__)
+  EXPECT_TRUE(detail::SimdComparator<int32_t>::is_supported);
+  EXPECT_TRUE(detail::SimdComparator<int64_t>::is_supported);
+  EXPECT_TRUE(detail::SimdComparator<float>::is_supported);
+  EXPECT_TRUE(detail::SimdComparator<double>::is_supported);
+#else
+  EXPECT_FALSE(detail::SimdComparator<int32_t>::is_supported);
+#endif
+  EXPECT_FALSE(detail::SimdComparator<std::string>::is_supported);
+}
+
+TEST_F(OperatorsScanKernelsTest, SimdCodeComparator) {
+#if defined(__AVX2__) || defined(__SSE4_2__)
+  EXPECT_TRUE(detail::SimdCodeComparator<uint8_t>::is_supported);
+  EXPECT_TRUE(detail::SimdCodeComparator<uint16_t>::is_supported);
+  EXPECT_TRUE(detail::SimdCodeComparator<uint32_t>::is_supported);
+#else
+  EXPECT_FALSE(detail::SimdCodeComparator<uint8_t>::is_supported);
+#endif
+  EXPECT_FALSE(detail::SimdCodeComparator<uint64_t>::is_supported);
+}
+
+TEST_F(OperatorsScanKernelsTest, ScanCompare) {
+  EXPECT_TRUE(scan_compare<ScanType::OpLessThanEquals>(3, 3));
+  EXPECT_FALSE(scan_compare<ScanType::OpGreaterThan>(3, 3));
+  EXPECT_TRUE(scan_compare<ScanType::OpNotEquals>(std::string{"a"}, std::string{"b"}));
+}
+
+TEST_F(OperatorsScanKernelsTest, String) {
+  const auto values = std::vector<std::string>{"Bill", "Steve", "Alexander", "Steve", "Hasso", "Bill"};
+
+  check_all_scan_types<std::string>(values, "Bill");
+  check_all_scan_types<std::string>(values, "Carl");
+}
+
+}  // namespace opossum
@@ -13,6 +13,7 @@
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/contiguous_string_segment.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -73,6 +74,23 @@ class OperatorsTableScanTest : public BaseTest {
     return table_wrapper;
   }
 
+  // returns the positions that the output segments of a column reference, across all output chunks
+  PosList referenced_positions(const std::shared_ptr<const Table>& table, const ColumnID column_id) {
+    auto positions = PosList{};
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto segment =
+          std::dynamic_pointer_cast<const ReferenceSegment>(table->get_chunk(chunk_id).get_segment(column_id));
+      if (const auto single_chunk_pos_list = segment->single_chunk_pos_list()) {
+        for (const auto chunk_offset : single_chunk_pos_list->chunk_offsets) {
+          positions.emplace_back(RowID{single_chunk_pos_list->chunk_id, chunk_offset});
+        }
+      } else {
+        positions.insert(positions.end(), segment->pos_list()->cbegin(), segment->pos_list()->cend());
+      }
+    }
+    return positions;
+  }
+
   void ASSERT_COLUMN_EQ(std::shared_ptr<const Table> table, const ColumnID& column_id,
                         std::vector<AllTypeVariant> expected) {
     for (auto chunk_id = ChunkID{0u}; chunk_id < table->chunk_count(); ++chunk_id) {
@@ -169,6 +187,24 @@ TEST_F(OperatorsTableScanTest, ScanOnReferencedDictColumn) {
   }
 }
 
+TEST_F(OperatorsTableScanTest, ScanOnDictColumnValueNotInDictionary) {
+  // 5 lies between the dictionary entries 4 and 6 of the first chunk and must not be confused with either of them
+
+  std::map<ScanType, std::vector<AllTypeVariant>> tests;
+  tests[ScanType::OpEquals] = {};
+  tests[ScanType::OpNotEquals] = {100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 122, 124};
+  tests[ScanType::OpLessThan] = {100, 102, 104};
+  tests[ScanType::OpLessThanEquals] = {100, 102, 104};
+  tests[ScanType::OpGreaterThan] = {106, 108, 110, 112, 114, 116, 118, 120, 122, 124};
+  tests[ScanType::OpGreaterThanEquals] = {106, 108, 110, 112, 114, 116, 118, 120, 122, 124};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{0}, test.first, 5);
+    scan->execute();
+
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+  }
+}
+
 TEST_F(OperatorsTableScanTest, ScanPartiallyCompressed) {
   std::shared_ptr<Table> expected_result = load_table("../src/test/tables/int_float_seq_filtered.tbl", 2);
 
@@ -267,4 +303,341 @@ TEST_F(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_F(OperatorsTableScanTest, ParallelScanKeepsChunkOrder) {
+  auto table = std::make_shared<Table>(3);
+  table->add_column("a", "int");
+  for (int value = 0; value < 100; ++value) table->append({value % 7});
+  table->compress_chunk(ChunkID{2});
+  table->compress_chunk(ChunkID{5});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  for (const auto max_parallelism : {size_t{1}, size_t{4}, size_t{0}}) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3, max_parallelism);
+    scan->execute();
+
+    auto expected_pos_list = PosList{};
+    for (uint32_t row = 0; row < 100; ++row) {
+      if (row % 7 < 3) expected_pos_list.emplace_back(RowID{ChunkID{row / 3}, row % 3});
+    }
+    EXPECT_EQ(referenced_positions(scan->get_output(), ColumnID{0}), expected_pos_list);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanKeepsInputChunks) {
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (int value = 0; value < 50; ++value) table->append({value, value % 10});
+  table->compress_chunk(ChunkID{1});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Chunks 0 to 2 have matches, chunks 3 and 4 do not
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 25);
+  scan_1->execute();
+  const auto& output_1 = scan_1->get_output();
+  ASSERT_EQ(output_1->chunk_count(), 3u);
+  EXPECT_EQ(output_1->chunk_size(), 10u);
+  for (ChunkID chunk_id{0}; chunk_id < output_1->chunk_count(); ++chunk_id) {
+    const auto& chunk = output_1->get_chunk(chunk_id);
+    const auto segment_a = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+    const auto segment_b = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(ColumnID{1}));
+    ASSERT_TRUE(segment_a->single_chunk_pos_list());
+    EXPECT_EQ(segment_a->single_chunk_pos_list(), segment_b->single_chunk_pos_list());
+    EXPECT_EQ(segment_a->single_chunk_pos_list()->chunk_id, chunk_id);
+  }
+  EXPECT_EQ(output_1->get_chunk(ChunkID{2}).size(), 5u);
+
+  // The second scan maps its matches to the rows of the base table and drops chunk 2, which has no matches
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpGreaterThanEquals, 7);
+  scan_2->execute();
+  const auto& output_2 = scan_2->get_output();
+  ASSERT_EQ(output_2->chunk_count(), 2u);
+  for (ChunkID chunk_id{0}; chunk_id < output_2->chunk_count(); ++chunk_id) {
+    for (ColumnID column_id{0}; column_id < output_2->column_count(); ++column_id) {
+      const auto segment =
+          std::dynamic_pointer_cast<const ReferenceSegment>(output_2->get_chunk(chunk_id).get_segment(column_id));
+      EXPECT_EQ(segment->referenced_table(), table);
+      EXPECT_EQ(segment->referenced_column_id(), column_id);
+    }
+  }
+  EXPECT_EQ(referenced_positions(output_2, ColumnID{1}),
+            (PosList{RowID{ChunkID{0}, 7}, RowID{ChunkID{0}, 8}, RowID{ChunkID{0}, 9}, RowID{ChunkID{1}, 7},
+                     RowID{ChunkID{1}, 8}, RowID{ChunkID{1}, 9}}));
+
+  auto scan_3 = std::make_shared<TableScan>(scan_2, ColumnID{0}, ScanType::OpEquals, 18);
+  scan_3->execute();
+  ASSERT_EQ(scan_3->get_output()->chunk_count(), 1u);
+  EXPECT_EQ(referenced_positions(scan_3->get_output(), ColumnID{0}), (PosList{RowID{ChunkID{1}, 8}}));
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnReferenceSegmentsAcrossChunks) {
+  auto table = std::make_shared<Table>(3);
+  table->add_column("a", "int");
+  for (int value = 0; value < 9; ++value) table->append({value});
+
+  // The input references rows of all three chunks, so the output positions cannot be stored for a single chunk
+  const auto pos_list = std::make_shared<PosList>(
+      PosList{RowID{ChunkID{2}, 2}, RowID{ChunkID{0}, 1}, RowID{ChunkID{1}, 0}, RowID{ChunkID{0}, 0}});
+  auto chunk = Chunk{};
+  chunk.add_segment(std::make_shared<ReferenceSegment>(table, ColumnID{0}, pos_list));
+  auto input_table = std::make_shared<Table>();
+  input_table->add_column_definition("a", "int");
+  input_table->emplace_chunk(std::move(chunk));
+
+  auto table_wrapper = std::make_shared<TableWrapper>(input_table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+
+  const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(
+      scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_FALSE(segment->single_chunk_pos_list());
+  EXPECT_EQ(segment->referenced_table(), table);
+  EXPECT_EQ(*segment->pos_list(), (PosList{RowID{ChunkID{2}, 2}, RowID{ChunkID{0}, 1}, RowID{ChunkID{1}, 0}}));
+}
+
+TEST_F(OperatorsTableScanTest, ScanRejectsUnsupportedSegment) {
+  // A segment whose values are not of the column type cannot be scanned and must not yield an empty result
+  auto chunk = Chunk{};
+  chunk.add_segment(std::make_shared<ValueSegment<float>>(std::vector<float>{1.0f, 2.0f}));
+  auto table = std::make_shared<Table>();
+  table->add_column_definition("a", "int");
+  table->emplace_chunk(std::move(chunk));
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 1);
+  EXPECT_THROW(scan->execute(), std::exception);
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnBitPackedDictionarySegment) {
+  // 300 distinct values need 9 bits per value id. 2500 rows cover several decode blocks.
+  auto table = std::make_shared<Table>(0);
+  table->add_column("a", "int");
+  for (int value = 0; value < 2500; ++value) table->append({value % 300});
+  table->compress_chunk(ChunkID{0}, {EncodingType::Dictionary, VectorCompressionType::BitPacked});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Values below 100 occur 9 times, all others 8 times
+  const auto tests = std::map<ScanType, size_t>{
+      {ScanType::OpEquals, 8},        {ScanType::OpNotEquals, 2492},     {ScanType::OpLessThan, 2100},
+      {ScanType::OpLessThanEquals, 2108}, {ScanType::OpGreaterThan, 392}, {ScanType::OpGreaterThanEquals, 400}};
+  for (const auto& [scan_type, expected_row_count] : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, 250);
+    scan->execute();
+    EXPECT_EQ(scan->get_output()->row_count(), expected_row_count) << "scan type " << static_cast<int>(scan_type);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnRunLengthSegment) {
+  // Runs of length 1 to 9 with the values 0, 1, ..., 8 in the first chunk and in reverse order in the second one
+  auto table = std::make_shared<Table>(45);
+  table->add_column("a", "int");
+  for (int value = 0; value < 9; ++value) {
+    for (int row = 0; row <= value; ++row) table->append({value});
+  }
+  for (int value = 8; value >= 0; --value) {
+    for (int row = 0; row <= value; ++row) table->append({value});
+  }
+  table->compress_chunk(ChunkID{0}, {EncodingType::RunLength});
+  table->compress_chunk(ChunkID{1}, {EncodingType::RunLength});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Rows with a value of 4 or less make up 1 + 2 + 3 + 4 + 5 = 15 rows in each chunk
+  const auto tests = std::map<ScanType, size_t>{
+      {ScanType::OpEquals, 10},       {ScanType::OpNotEquals, 80},    {ScanType::OpLessThan, 20},
+      {ScanType::OpLessThanEquals, 30}, {ScanType::OpGreaterThan, 60}, {ScanType::OpGreaterThanEquals, 70}};
+  for (const auto& [scan_type, expected_row_count] : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, 4);
+    scan->execute();
+    EXPECT_EQ(scan->get_output()->row_count(), expected_row_count) << "scan type " << static_cast<int>(scan_type);
+  }
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 1);
+  scan->execute();
+  EXPECT_EQ(referenced_positions(scan->get_output(), ColumnID{0}),
+            (PosList{RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}, RowID{ChunkID{1}, 42}, RowID{ChunkID{1}, 43}}));
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrameOfReferenceSegment) {
+  // The first two chunks use plain frame of reference encoding, the other two the delta variant
+  auto table = std::make_shared<Table>(1500);
+  table->add_column("a", "int");
+  table->add_column("b", "long");
+  for (int value = 0; value < 6000; ++value) {
+    table->append({value < 3000 ? (value * 37) % 1000 - 500 : value, int64_t{value} * 1000000000});
+  }
+  table->compress_chunk(ChunkID{0}, {EncodingType::FrameOfReference});
+  table->compress_chunk(ChunkID{1}, {EncodingType::FrameOfReference});
+  table->compress_chunk(ChunkID{2}, {EncodingType::FrameOfReferenceDelta});
+  table->compress_chunk(ChunkID{3}, {EncodingType::FrameOfReferenceDelta});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Compare the result with a scan on an unencoded copy of the table
+  auto expected_table = std::make_shared<Table>(1500);
+  expected_table->add_column("a", "int");
+  expected_table->add_column("b", "long");
+  for (int value = 0; value < 6000; ++value) {
+    expected_table->append({value < 3000 ? (value * 37) % 1000 - 500 : value, int64_t{value} * 1000000000});
+  }
+  auto expected_table_wrapper = std::make_shared<TableWrapper>(expected_table);
+  expected_table_wrapper->execute();
+
+  const auto search_values = std::vector<std::pair<ColumnID, AllTypeVariant>>{
+      {ColumnID{0}, -501}, {ColumnID{0}, -500}, {ColumnID{0}, 17}, {ColumnID{0}, 499}, {ColumnID{0}, 4500},
+      {ColumnID{1}, int64_t{0}}, {ColumnID{1}, int64_t{1234567890123}}, {ColumnID{1}, int64_t{-1}}};
+  for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                               ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+    for (const auto& [column_id, search_value] : search_values) {
+      auto scan = std::make_shared<TableScan>(table_wrapper, column_id, scan_type, search_value);
+      scan->execute();
+      auto expected_scan = std::make_shared<TableScan>(expected_table_wrapper, column_id, scan_type, search_value);
+      expected_scan->execute();
+
+      EXPECT_EQ(referenced_positions(scan->get_output(), ColumnID{0}),
+                referenced_positions(expected_scan->get_output(), ColumnID{0}))
+          << "scan type " << static_cast<int>(scan_type) << ", search value " << search_value;
+    }
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnGorillaSegment) {
+  auto table = std::make_shared<Table>(1500);
+  table->add_column("a", "double");
+  table->add_column("b", "float");
+  for (int value = 0; value < 3000; ++value) table->append({value * 0.5, static_cast<float>(value % 10)});
+  table->compress_chunk(ChunkID{0}, {EncodingType::Gorilla});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // The second chunk is not compressed
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 700.0);
+  scan_1->execute();
+  EXPECT_EQ(scan_1->get_output()->row_count(), 1400u);
+
+  auto scan_2 = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpEquals, 3.0f);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->row_count(), 300u);
+
+  auto scan_3 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 1000.0);
+  scan_3->execute();
+  EXPECT_EQ(scan_3->get_output()->row_count(), 1000u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnContiguousStringSegment) {
+  auto values = std::vector<std::string>{};
+  for (int row = 0; row < 100; ++row) values.emplace_back(row % 2 == 0 ? "" : "customer#" + std::to_string(row % 10));
+  auto chunk = Chunk{};
+  chunk.add_segment(std::make_shared<ContiguousStringSegment>(ValueSpan<std::string>{values}));
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "string");
+  table->emplace_chunk(std::move(chunk));
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto tests = std::map<std::pair<ScanType, std::string>, size_t>{{{ScanType::OpEquals, "customer#3"}, 10},
+                                                                         {{ScanType::OpEquals, ""}, 50},
+                                                                         {{ScanType::OpNotEquals, "customer#3"}, 90},
+                                                                         {{ScanType::OpLessThan, "customer#5"}, 70},
+                                                                         {{ScanType::OpGreaterThan, "customer"}, 50}};
+  for (const auto& [scan, expected_row_count] : tests) {
+    auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan.first, scan.second);
+    table_scan->execute();
+    EXPECT_EQ(table_scan->get_output()->row_count(), expected_row_count) << scan.second;
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrontCodedDictionarySegment) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "string");
+  for (int row = 0; row < 200; ++row) table->append({"customer#" + std::to_string(row % 50)});
+  table->compress_chunk(ChunkID{0}, {EncodingType::FrontCodedDictionary});
+  table->compress_chunk(ChunkID{1}, {EncodingType::FrontCodedDictionary, VectorCompressionType::BitPacked});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // customer#0, customer#1, and customer#10 to customer#19 are smaller than customer#2
+  const auto tests = std::map<std::pair<ScanType, std::string>, size_t>{
+      {{ScanType::OpEquals, "customer#7"}, 4},         {{ScanType::OpEquals, "customer#70"}, 0},
+      {{ScanType::OpNotEquals, "customer#7"}, 196},    {{ScanType::OpLessThan, "customer#2"}, 48},
+      {{ScanType::OpLessThanEquals, "customer#2"}, 52}, {{ScanType::OpGreaterThan, "customer#49"}, 20},
+      {{ScanType::OpGreaterThanEquals, "a"}, 200}};
+  for (const auto& [scan, expected_row_count] : tests) {
+    auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan.first, scan.second);
+    table_scan->execute();
+    EXPECT_EQ(table_scan->get_output()->row_count(), expected_row_count) << scan.second;
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanPrunesChunksWithStatistics) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (int value = 0; value < 1000; ++value) table->append({value});
+  table->compress_chunk(ChunkID{3}, {EncodingType::RunLength});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Chunks 0 to 8 have statistics, the last one is still open and has to be scanned
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 350);
+  scan_1->execute();
+  EXPECT_EQ(scan_1->get_output()->row_count(), 350u);
+
+  auto scan_2 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpNotEquals, 950);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->row_count(), 999u);
+
+  auto scan_3 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 299);
+  scan_3->execute();
+  const auto& output = scan_3->get_output();
+  EXPECT_EQ(output->row_count(), 701u);
+  // 299 is the only match of the third input chunk, the following chunks match completely
+  EXPECT_EQ(output->chunk_count(), 8u);
+  EXPECT_EQ(type_cast<int>((*output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0]), 299);
+  EXPECT_EQ(type_cast<int>((*output->get_chunk(ChunkID{1}).get_segment(ColumnID{0}))[0]), 300);
+}
+
+TEST_F(OperatorsTableScanTest, ScanWithBloomFilters) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  // The values of all chunks cover the same range, so that min and max cannot prune equality predicates
+  for (int value = 0; value < 1000; ++value) {
+    const auto scattered = (value % 10) * 100 + value / 10;
+    table->append({scattered, "order#" + std::to_string(scattered)});
+  }
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    table->compress_chunk(chunk_id, {EncodingType::Dictionary, VectorCompressionType::FixedSizeByteAligned, 10});
+  }
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpEquals, "order#512");
+  scan_1->execute();
+  ASSERT_EQ(scan_1->get_output()->row_count(), 1u);
+  EXPECT_EQ(type_cast<int>((*scan_1->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0]), 512);
+
+  auto scan_2 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpNotEquals, 77);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->row_count(), 999u);
+
+  auto scan_3 = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpEquals, "order#1000");
+  scan_3->execute();
+  EXPECT_EQ(scan_3->get_output()->row_count(), 0u);
+}
+
 }  // namespace opossum
@@ -0,0 +1,80 @@
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/scheduler/worker_pool.hpp"
+
+namespace opossum {
+
+class WorkerPoolTest : public BaseTest {};
+
+TEST_F(WorkerPoolTest, ExecutesEveryTaskOnce) {
+  std::vector<std::atomic<uint32_t>> counters(100);
+  std::vector<std::function<void()>> tasks;
+  for (auto& counter : counters) {
+    tasks.emplace_back([&counter]() { ++counter; });
+  }
+
+  WorkerPool::get().execute_tasks(tasks);
+
+  for (const auto& counter : counters) {
+    EXPECT_EQ(counter, 1u);
+  }
+}
+
+TEST_F(WorkerPoolTest, EmptyBatch) { WorkerPool::get().execute_tasks({}); }
+
+TEST_F(WorkerPoolTest, NestedBatches) {
+  // Tasks that wait for batches of their own must not dead-lock, even if they occupy all workers
+  std::atomic<uint32_t> counter{0};
+  std::vector<std::function<void()>> tasks;
+  for (size_t task_id = 0; task_id < 2 * WorkerPool::get().worker_count() + 2; ++task_id) {
+    tasks.emplace_back([&counter]() {
+      std::vector<std::function<void()>> inner_tasks(4, [&counter]() { ++counter; });
+      WorkerPool::get().execute_tasks(inner_tasks);
+    });
+  }
+
+  WorkerPool::get().execute_tasks(tasks);
+
+  EXPECT_EQ(counter, tasks.size() * 4);
+}
+
+TEST_F(WorkerPoolTest, SingleThreaded) {
+  // With a parallelism of one, all tasks are executed by the calling thread in order
+  std::vector<uint32_t> order;
+  std::vector<std::function<void()>> tasks;
+  for (uint32_t task_id = 0; task_id < 10; ++task_id) {
+    tasks.emplace_back([&order, task_id]() { order.push_back(task_id); });
+  }
+
+  WorkerPool::get().execute_tasks(tasks, 1);
+
+  EXPECT_EQ(order, std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_F(WorkerPoolTest, RethrowsException) {
+  std::atomic<uint32_t> counter{0};
+  std::vector<std::function<void()>> tasks(8, [&counter]() { ++counter; });
+  tasks[3] = []() { throw std::logic_error("task failed"); };
+
+  EXPECT_THROW(WorkerPool::get().execute_tasks(tasks), std::logic_error);
+  EXPECT_EQ(counter, 7u);
+}
+
+TEST_F(WorkerPoolTest, Schedule) {
+  std::atomic<uint32_t> counter{0};
+  auto future = WorkerPool::get().schedule([&counter]() { ++counter; });
+  future.get();
+  EXPECT_EQ(counter, 1u);
+
+  auto failing_future = WorkerPool::get().schedule([]() { throw std::logic_error("job failed"); });
+  EXPECT_THROW(failing_future.get(), std::logic_error);
+}
+
+}  // namespace opossum
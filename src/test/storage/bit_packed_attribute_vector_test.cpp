@@ -0,0 +1,74 @@
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/bit_packed_attribute_vector.hpp"
+#include "../../lib/storage/bit_packed_vector.hpp"
+
+namespace opossum {
+
+class StorageBitPackedAttributeVectorTest : public ::testing::Test {};
+
+TEST_F(StorageBitPackedAttributeVectorTest, GetSet) {
+  auto attribute_vector = std::make_shared<BitPackedAttributeVector>(4, 9);
+  attribute_vector->set(0, ValueID{299});
+  attribute_vector->set(1, ValueID{1});
+  attribute_vector->set(2, ValueID{0});
+  attribute_vector->set(3, ValueID{511});
+  attribute_vector->set(1, ValueID{256});
+
+  EXPECT_EQ(attribute_vector->get(0), ValueID{299});
+  EXPECT_EQ(attribute_vector->get(1), ValueID{256});
+  EXPECT_EQ(attribute_vector->get(2), ValueID{0});
+  EXPECT_EQ(attribute_vector->get(3), ValueID{511});
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, SizeAndWidth) {
+  auto attribute_vector = std::make_shared<BitPackedAttributeVector>(100, 9);
+  EXPECT_EQ(attribute_vector->size(), 100u);
+  EXPECT_EQ(attribute_vector->bit_width(), 9u);
+  EXPECT_EQ(attribute_vector->width(), 2u);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, AllBitWidths) {
+  // Values that span two words and neighbouring values must not interfere with each other
+  for (uint8_t bit_width = 1; bit_width <= 32; ++bit_width) {
+    const auto max_value = static_cast<uint32_t>((uint64_t{1} << bit_width) - 1);
+    auto attribute_vector = BitPackedAttributeVector(200, bit_width);
+    for (uint32_t index = 0; index < 200; ++index) {
+      attribute_vector.set(index, ValueID{index % 3 == 0 ? max_value : (index * 2654435761u) & max_value});
+    }
+
+    auto decoded = std::vector<ValueID::base_type>(150);
+    attribute_vector.decode(ChunkOffset{37}, 150, decoded.data());
+
+    for (uint32_t index = 0; index < 200; ++index) {
+      const auto expected = index % 3 == 0 ? max_value : (index * 2654435761u) & max_value;
+      EXPECT_EQ(attribute_vector.get(index), ValueID{expected}) << "bit width " << static_cast<int>(bit_width);
+      if (index >= 37 && index < 187) EXPECT_EQ(decoded[index - 37], expected);
+    }
+  }
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, RequiredBitWidth) {
+  EXPECT_EQ(BitPackedVector::required_bit_width(0), 1u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(1), 1u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(299), 9u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(511), 9u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(512), 10u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(~uint64_t{0}), 64u);
+}
+
+TEST_F(StorageBitPackedAttributeVectorTest, SixtyFourBitValues) {
+  auto vector = BitPackedVector(3, 64);
+  vector.set(0, ~uint64_t{0});
+  vector.set(1, 42);
+  vector.set(2, uint64_t{1} << 63);
+
+  EXPECT_EQ(vector.get(0), ~uint64_t{0});
+  EXPECT_EQ(vector.get(1), 42u);
+  EXPECT_EQ(vector.get(2), uint64_t{1} << 63);
+}
+
+}  // namespace opossum
@@ -0,0 +1,69 @@
+#include <cmath>
+#include <functional>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/bloom_filter.hpp"
+
+namespace opossum {
+
+class StorageBloomFilterTest : public ::testing::Test {};
+
+TEST_F(StorageBloomFilterTest, NoFalseNegatives) {
+  auto filter = BloomFilter{10000, 10};
+  for (int value = 0; value < 10000; value += 2) filter.insert(std::hash<int>{}(value));
+
+  for (int value = 0; value < 10000; value += 2) {
+    EXPECT_TRUE(filter.may_contain(std::hash<int>{}(value)));
+  }
+}
+
+TEST_F(StorageBloomFilterTest, FalsePositiveRate) {
+  auto filter = BloomFilter{10000, 10};
+  for (int value = 0; value < 10000; ++value) filter.insert(std::hash<std::string>{}("order#" + std::to_string(value)));
+
+  EXPECT_EQ(filter.hash_count(), 7u);
+  EXPECT_GE(filter.bit_count(), 100000u);
+
+  // Ten bits per value give about one percent of false positives, a blocked filter slightly more
+  auto false_positive_count = 0;
+  for (int value = 10000; value < 20000; ++value) {
+    if (filter.may_contain(std::hash<std::string>{}("order#" + std::to_string(value)))) ++false_positive_count;
+  }
+  EXPECT_LT(false_positive_count, 300);
+}
+
+TEST_F(StorageBloomFilterTest, FalsePositiveRateMatchesBitsPerValue) {
+  constexpr auto value_count = 20000;
+  for (const auto bits_per_value : {4u, 8u, 10u, 16u}) {
+    auto filter = BloomFilter{value_count, bits_per_value};
+    for (int value = 0; value < value_count; ++value) filter.insert(std::hash<int>{}(value));
+
+    auto false_positive_count = 0;
+    for (int value = value_count; value < 11 * value_count; ++value) {
+      if (filter.may_contain(std::hash<int>{}(value))) ++false_positive_count;
+    }
+    const auto measured_rate = false_positive_count / (10.0 * value_count);
+
+    // The expected rate of a blocked filter: the number of values in a block follows a Poisson distribution with a
+    // mean of 512 / bits_per_value, and a block with n values answers wrongly with (1 - (1 - 1/512)^(k * n))^k
+    const auto hash_count = static_cast<double>(filter.hash_count());
+    const auto mean = 512.0 / bits_per_value;
+    auto expected_rate = 0.0;
+    for (auto block_value_count = 0; block_value_count < 1000; ++block_value_count) {
+      const auto probability = std::exp(block_value_count * std::log(mean) - mean - std::lgamma(block_value_count + 1));
+      const auto unset_probability = std::pow(1.0 - 1.0 / 512, hash_count * block_value_count);
+      expected_rate += probability * std::pow(1.0 - unset_probability, hash_count);
+    }
+    EXPECT_LT(measured_rate, 1.2 * expected_rate) << bits_per_value << " bits per value";
+  }
+}
+
+TEST_F(StorageBloomFilterTest, Empty) {
+  auto filter = BloomFilter{0, 8};
+  EXPECT_EQ(filter.bit_count(), 512u);
+  EXPECT_FALSE(filter.may_contain(std::hash<int>{}(17)));
+}
+
+}  // namespace opossum
@@ -0,0 +1,59 @@
+#include <memory>
+#include <thread>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/chunk.hpp"
+#include "../lib/storage/chunk_list.hpp"
+
+namespace opossum {
+
+class StorageChunkListTest : public BaseTest {
+ protected:
+  ChunkList chunks;
+};
+
+TEST_F(StorageChunkListTest, PushBack) {
+  EXPECT_EQ(chunks.size(), 0u);
+
+  // Spans several blocks
+  for (auto index = 0; index < 1000; ++index) {
+    chunks.push_back(std::make_shared<Chunk>());
+  }
+  EXPECT_EQ(chunks.size(), 1000u);
+  EXPECT_NE(chunks[0], chunks[999]);
+  EXPECT_EQ(chunks.back(), chunks[999]);
+}
+
+TEST_F(StorageChunkListTest, EntriesAreNotMoved) {
+  chunks.push_back(std::make_shared<Chunk>());
+  const auto* first_entry = &chunks[0];
+  for (auto index = 0; index < 1000; ++index) {
+    chunks.push_back(std::make_shared<Chunk>());
+  }
+  EXPECT_EQ(first_entry, &chunks[0]);
+}
+
+TEST_F(StorageChunkListTest, Replace) {
+  chunks.push_back(std::make_shared<Chunk>());
+  const auto chunk = std::make_shared<Chunk>();
+  chunks.replace(0, chunk);
+  EXPECT_EQ(chunks[0], chunk);
+  EXPECT_EQ(chunks.size(), 1u);
+}
+
+TEST_F(StorageChunkListTest, ReadWhilePushingBack) {
+  auto reader = std::thread([this]() {
+    while (chunks.size() < 10000) {
+      const auto size = chunks.size();
+      if (size > 0) ASSERT_TRUE(chunks[size - 1]);
+    }
+  });
+  for (auto index = 0; index < 10000; ++index) {
+    chunks.push_back(std::make_shared<Chunk>());
+  }
+  reader.join();
+}
+
+}  // namespace opossum
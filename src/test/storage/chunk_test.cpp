@@ -58,6 +58,30 @@ TEST_F(StorageChunkTest, RetrieveSegment) {
   EXPECT_EQ(base_segment->size(), 4u);
 }
 
+TEST_F(StorageChunkTest, ReplaceSegments) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  const auto old_segments = c.segments();
+
+  auto new_int_segment = make_shared_by_data_type<BaseSegment, ValueSegment>("int");
+  auto new_string_segment = make_shared_by_data_type<BaseSegment, ValueSegment>("string");
+  for (ChunkOffset chunk_offset = 0; chunk_offset < c.size(); ++chunk_offset) {
+    new_int_segment->append((*int_value_segment)[chunk_offset]);
+    new_string_segment->append((*string_value_segment)[chunk_offset]);
+  }
+  c.replace_segments({new_int_segment, new_string_segment});
+
+  EXPECT_EQ(c.get_segment(ColumnID{0}), new_int_segment);
+  EXPECT_EQ(c.get_segment(ColumnID{1}), new_string_segment);
+  // Readers that got the segments before keep all of the old ones
+  EXPECT_EQ((*old_segments)[0], int_value_segment);
+  EXPECT_EQ((*old_segments)[1], string_value_segment);
+
+  if (IS_DEBUG) {
+    EXPECT_THROW(c.replace_segments({new_int_segment}), std::logic_error);
+  }
+}
+
 TEST_F(StorageChunkTest, UnknownSegmentType) {
   // Exception will only be thrown in debug builds
   if (IS_DEBUG) {
@@ -0,0 +1,81 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/contiguous_string_segment.hpp"
+#include "../../lib/storage/dictionary_segment.hpp"
+#include "../../lib/storage/run_length_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/segment_statistics.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageContiguousStringSegmentTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> values{"Bill", "Bill", "", "Alexander", "Alexander", "a string that is not stored inline"};
+  std::shared_ptr<ContiguousStringSegment> segment =
+      std::make_shared<ContiguousStringSegment>(ValueSpan<std::string>{values});
+};
+
+TEST_F(StorageContiguousStringSegmentTest, Get) {
+  ASSERT_EQ(segment->size(), values.size());
+  for (size_t offset = 0; offset < values.size(); ++offset) {
+    EXPECT_EQ(segment->get(offset), values[offset]);
+    EXPECT_EQ(type_cast<std::string>((*segment)[offset]), values[offset]);
+  }
+  EXPECT_EQ(segment->character_count(), 60u);
+  EXPECT_EQ(std::string(segment->characters(), 8), "BillBill");
+  EXPECT_EQ(segment->end_offsets()[2], 8u);
+  EXPECT_THROW(segment->append("Steve"), std::exception);
+}
+
+TEST_F(StorageContiguousStringSegmentTest, Buffers) {
+  auto characters = std::vector<char>{'a', 'b', 'c'};
+  auto end_offsets = std::vector<uint64_t>{1, 1, 3};
+  const auto owned = ContiguousStringSegment{std::move(characters), std::move(end_offsets)};
+  EXPECT_EQ(owned.size(), 3u);
+  EXPECT_EQ(owned.get(0), "a");
+  EXPECT_EQ(owned.get(1), "");
+  EXPECT_EQ(owned.get(2), "bc");
+
+  // A wrapping segment keeps the owner of the strings alive
+  const auto wrapped = ContiguousStringSegment{segment->characters(), segment->end_offsets(), 2, segment};
+  segment.reset();
+  EXPECT_EQ(wrapped.size(), 2u);
+  EXPECT_EQ(wrapped.get(1), "Bill");
+  EXPECT_EQ(wrapped.character_count(), 8u);
+}
+
+TEST_F(StorageContiguousStringSegmentTest, EstimateMemoryUsage) {
+  EXPECT_GE(segment->estimate_memory_usage(), sizeof(ContiguousStringSegment) + 60 + 6 * sizeof(uint64_t));
+  const auto value_segment = ValueSegment<std::string>{std::vector<std::string>{values}};
+  EXPECT_LT(segment->estimate_memory_usage(), value_segment.estimate_memory_usage());
+}
+
+TEST_F(StorageContiguousStringSegmentTest, Encode) {
+  const auto dictionary_segment = std::make_shared<DictionarySegment<std::string>>(segment);
+  EXPECT_EQ(*dictionary_segment->dictionary(),
+            (std::vector<std::string>{"", "Alexander", "Bill", "a string that is not stored inline"}));
+  EXPECT_EQ(dictionary_segment->get(3), "Alexander");
+
+  const auto run_length_segment = std::make_shared<RunLengthSegment<std::string>>(segment);
+  EXPECT_EQ(run_length_segment->run_count(), 4u);
+  EXPECT_EQ(run_length_segment->get(5), values[5]);
+
+  const auto statistics =
+      std::dynamic_pointer_cast<SegmentStatistics<std::string>>(create_segment_statistics("string", segment, 8));
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(statistics->min(), "");
+  EXPECT_EQ(statistics->max(), "a string that is not stored inline");
+  EXPECT_TRUE(statistics->bloom_filter()->may_contain(std::hash<std::string>{}("Bill")));
+
+  EXPECT_EQ(segment_encoding_name("string", segment), "Unencoded (Contiguous)");
+  EXPECT_EQ(encode_segment("string", segment, {EncodingType::Unencoded}), segment);
+  EXPECT_NE(encode_segment("string", segment, {EncodingType::Automatic}), nullptr);
+}
+
+}  // namespace opossum
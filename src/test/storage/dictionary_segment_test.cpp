@@ -56,6 +56,24 @@ TEST_F(StorageDictionarySegmentTest, LowerUpperBound) {
   EXPECT_EQ(dict_col->upper_bound(15), opossum::INVALID_VALUE_ID);
 }
 
+TEST_F(StorageDictionarySegmentTest, LowerUpperBoundWithSearchIndex) {
+  // Enough distinct values for an EytzingerIndex
+  const auto distinct_count = static_cast<int>(opossum::DictionarySegment<int>::search_index_min_size) * 2;
+  for (int i = 0; i < distinct_count; ++i) vc_int->append((i * 7919) % distinct_count * 2);
+  auto dict_col = std::make_shared<opossum::DictionarySegment<int>>(vc_int);
+  EXPECT_GT(dict_col->estimate_memory_usage(),
+            static_cast<size_t>(distinct_count) * (sizeof(int) + sizeof(uint16_t) + sizeof(int)));
+
+  EXPECT_EQ(dict_col->lower_bound(-1), (opossum::ValueID)0);
+  EXPECT_EQ(dict_col->lower_bound(4), (opossum::ValueID)2);
+  EXPECT_EQ(dict_col->upper_bound(4), (opossum::ValueID)3);
+  EXPECT_EQ(dict_col->lower_bound(5), (opossum::ValueID)3);
+  EXPECT_EQ(dict_col->upper_bound(5), (opossum::ValueID)3);
+  EXPECT_EQ(dict_col->lower_bound(distinct_count * 2 - 2), opossum::ValueID(distinct_count - 1));
+  EXPECT_EQ(dict_col->upper_bound(distinct_count * 2 - 2), opossum::INVALID_VALUE_ID);
+  EXPECT_EQ(dict_col->lower_bound(distinct_count * 2), opossum::INVALID_VALUE_ID);
+}
+
 TEST_F(StorageDictionarySegmentTest, GetAppend) {
   for (int i = 0; i <= 10; i += 2) vc_int->append(i);
   auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("int", vc_int);
@@ -96,3 +114,43 @@ TEST_F(StorageDictionarySegmentTest, FittedAttributeVectorDuplicates) {
 
   EXPECT_EQ(dict_col->attribute_vector()->width(), 1);
 }
+
+TEST_F(StorageDictionarySegmentTest, BitPackedAttributeVector) {
+  for (int i = 0; i < 300; i++) vc_int->append(i);
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>(
+      "int", vc_int, opossum::VectorCompressionType::BitPacked);
+  auto dict_col = std::dynamic_pointer_cast<opossum::DictionarySegment<int>>(col);
+
+  const auto attribute_vector =
+      std::dynamic_pointer_cast<const opossum::BitPackedAttributeVector>(dict_col->attribute_vector());
+  ASSERT_TRUE(attribute_vector);
+  EXPECT_EQ(attribute_vector->bit_width(), 9u);
+  EXPECT_EQ(dict_col->get(0), 0);
+  EXPECT_EQ(dict_col->get(299), 299);
+}
+
+TEST_F(StorageDictionarySegmentTest, EstimateMemoryUsage) {
+  for (auto row = 0; row < 1000; ++row) {
+    vc_str->append("a string that is too long to be stored inline " + std::to_string(row % 10));
+  }
+  const auto dict_col = std::make_shared<opossum::DictionarySegment<std::string>>(vc_str);
+
+  // Ten dictionary entries and one byte per row
+  EXPECT_GE(dict_col->estimate_memory_usage(), 10 * sizeof(std::string) + 1000u);
+  EXPECT_LT(dict_col->estimate_memory_usage(), vc_str->estimate_memory_usage() / 10);
+}
+
+TEST_F(StorageDictionarySegmentTest, EncodeInParallel) {
+  // Enough rows for the value ids to be assigned by several tasks
+  for (int i = 0; i < 200000; i++) vc_int->append((i * 7919) % 1000);
+
+  for (const auto vector_compression :
+       {opossum::VectorCompressionType::FixedSizeByteAligned, opossum::VectorCompressionType::BitPacked}) {
+    auto dict_col = std::make_shared<opossum::DictionarySegment<int>>(vc_int, vector_compression);
+
+    EXPECT_EQ(dict_col->unique_values_count(), 1000u);
+    for (int i = 0; i < 200000; i++) {
+      ASSERT_EQ(dict_col->get(i), (i * 7919) % 1000);
+    }
+  }
+}
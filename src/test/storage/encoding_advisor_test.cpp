@@ -0,0 +1,116 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/encoding_advisor.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageEncodingAdvisorTest : public ::testing::Test {
+ protected:
+  template <typename T>
+  static std::shared_ptr<ValueSegment<T>> make_segment(const size_t row_count, T (*value_of)(size_t)) {
+    auto values = std::vector<T>(row_count);
+    for (size_t row = 0; row < row_count; ++row) {
+      values[row] = value_of(row);
+    }
+    return std::make_shared<ValueSegment<T>>(std::move(values));
+  }
+};
+
+TEST_F(StorageEncodingAdvisorTest, ProfileSmallSegment) {
+  const auto segment = make_segment<int32_t>(100, [](size_t row) { return static_cast<int32_t>(row / 10); });
+  const auto profile = profile_segment("int", segment);
+
+  // Small segments are sampled completely
+  EXPECT_EQ(profile.row_count, 100u);
+  EXPECT_EQ(profile.sampled_row_count, 100u);
+  EXPECT_EQ(profile.distinct_count, 10u);
+  EXPECT_EQ(profile.run_count, 10u);
+  EXPECT_EQ(profile.value_bytes, sizeof(int32_t));
+  EXPECT_TRUE(profile.is_sorted);
+  EXPECT_EQ(profile.frame_of_reference_bit_width, 4u);
+  EXPECT_EQ(profile.delta_bit_width, 1u);
+}
+
+TEST_F(StorageEncodingAdvisorTest, ProfileSampledSegment) {
+  const auto segment = make_segment<int64_t>(100'000, [](size_t row) { return static_cast<int64_t>(row * 7 % 1000); });
+  const auto profile = profile_segment("long", segment);
+
+  EXPECT_EQ(profile.sampled_row_count, encoding_sample_run_count * encoding_sample_run_length);
+  EXPECT_GT(profile.distinct_count, 500u);
+  EXPECT_LT(profile.distinct_count, 5000u);
+  EXPECT_EQ(profile.run_count, 100'000u);
+  EXPECT_FALSE(profile.is_sorted);
+}
+
+TEST_F(StorageEncodingAdvisorTest, ProfileStrings) {
+  const auto segment =
+      make_segment<std::string>(1000, [](size_t row) { return std::string(100, static_cast<char>('a' + row % 2)); });
+  const auto profile = profile_segment("string", segment);
+
+  // The characters of long strings are on the heap
+  EXPECT_GT(profile.value_bytes, sizeof(std::string) + 100);
+  EXPECT_EQ(profile.distinct_count, 2u);
+}
+
+TEST_F(StorageEncodingAdvisorTest, UnsupportedEncodings) {
+  const auto segment = make_segment<std::string>(10, [](size_t row) { return std::to_string(row); });
+  const auto profile = profile_segment("string", segment);
+  const auto compression = VectorCompressionType::FixedSizeByteAligned;
+
+  EXPECT_FALSE(estimate_encoded_bytes("string", profile, EncodingType::FrameOfReference, compression));
+  EXPECT_FALSE(estimate_encoded_bytes("string", profile, EncodingType::Gorilla, compression));
+  EXPECT_TRUE(estimate_encoded_bytes("string", profile, EncodingType::RunLength, compression));
+
+  const auto unsorted_segment = make_segment<int32_t>(10, [](size_t row) { return static_cast<int32_t>(10 - row); });
+  EXPECT_FALSE(estimate_encoded_bytes("int", profile_segment("int", unsorted_segment),
+                                      EncodingType::FrameOfReferenceDelta, compression));
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseEncoding) {
+  const auto advise = [](const std::string& type, const std::shared_ptr<BaseSegment>& segment) {
+    return advise_segment_encoding(type, segment).encoding_type;
+  };
+
+  const auto few_distinct = make_segment<std::string>(10'000, [](size_t row) { return std::to_string(row % 10); });
+  EXPECT_EQ(advise("string", few_distinct), EncodingType::Dictionary);
+
+  // Front coding the dictionary saves more than the value ids take once there are many distinct strings
+  const auto many_distinct = make_segment<std::string>(10'000, [](size_t row) { return std::to_string(row % 1000); });
+  EXPECT_EQ(advise("string", many_distinct), EncodingType::FrontCodedDictionary);
+
+  const auto long_runs = make_segment<int32_t>(10'000, [](size_t row) { return static_cast<int32_t>(row / 1000); });
+  EXPECT_EQ(advise("int", long_runs), EncodingType::RunLength);
+
+  const auto unique_keys = make_segment<int32_t>(10'000, [](size_t row) { return static_cast<int32_t>(row * 7); });
+  EXPECT_EQ(advise("int", unique_keys), EncodingType::FrameOfReferenceDelta);
+
+  const auto close_values =
+      make_segment<int64_t>(10'000, [](size_t row) { return static_cast<int64_t>((1ul << 40) + row * 7 % 9973); });
+  EXPECT_EQ(advise("long", close_values), EncodingType::FrameOfReference);
+
+  const auto measurements =
+      make_segment<double>(10'000, [](size_t row) { return 20.0 + static_cast<double>(row) / 4; });
+  EXPECT_EQ(advise("double", measurements), EncodingType::Gorilla);
+
+  const auto random_values =
+      make_segment<int32_t>(10'000, [](size_t row) { return static_cast<int32_t>(row * 2654435761u); });
+  EXPECT_EQ(advise("int", random_values), EncodingType::Unencoded);
+}
+
+TEST_F(StorageEncodingAdvisorTest, EncodeAutomatically) {
+  const auto segment = make_segment<int32_t>(10'000, [](size_t row) { return static_cast<int32_t>(row / 1000); });
+  const auto encoded_segment = encode_segment("int", segment, SegmentEncodingSpec{EncodingType::Automatic});
+
+  EXPECT_EQ(segment_encoding_name("int", encoded_segment), "RunLength");
+  EXPECT_EQ(encoded_segment->size(), 10'000u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/eytzinger_index.hpp"
+
+namespace opossum {
+
+class StorageEytzingerIndexTest : public ::testing::Test {
+ protected:
+  // Compares the bounds of the index with those of a binary search for the values, their neighbours, and the extremes
+  template <typename T>
+  static void expect_bounds(const std::vector<T>& sorted_values) {
+    const auto index = EytzingerIndex<T>{sorted_values};
+    ASSERT_EQ(index.size(), sorted_values.size());
+
+    auto probes = std::vector<T>{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()};
+    for (const auto value : sorted_values) {
+      probes.insert(probes.end(), {value, static_cast<T>(value - 1), static_cast<T>(value + 1)});
+    }
+    for (const auto probe : probes) {
+      const auto lower = std::lower_bound(sorted_values.cbegin(), sorted_values.cend(), probe);
+      const auto upper = std::upper_bound(sorted_values.cbegin(), sorted_values.cend(), probe);
+      ASSERT_EQ(index.lower_bound(probe), static_cast<size_t>(lower - sorted_values.cbegin())) << probe;
+      ASSERT_EQ(index.upper_bound(probe), static_cast<size_t>(upper - sorted_values.cbegin())) << probe;
+    }
+  }
+};
+
+TEST_F(StorageEytzingerIndexTest, AllSmallSizes) {
+  // Complete and incomplete trees of every shape up to seven levels
+  for (int32_t size = 0; size < 130; ++size) {
+    auto values = std::vector<int32_t>(size);
+    for (int32_t index = 0; index < size; ++index) values[index] = index * 3;
+    expect_bounds(values);
+  }
+}
+
+TEST_F(StorageEytzingerIndexTest, LargeIndex) {
+  auto values = std::vector<int64_t>(100'000);
+  for (size_t index = 0; index < values.size(); ++index) values[index] = static_cast<int64_t>(index * index) - 1000;
+  expect_bounds(values);
+  EXPECT_GT(EytzingerIndex<int64_t>{values}.estimate_memory_usage(), values.size() * (8 + 4));
+}
+
+TEST_F(StorageEytzingerIndexTest, FloatingPoint) {
+  expect_bounds(std::vector<double>{-2.5, -0.5, 0.0, 0.25, 1e10});
+
+  // NaN is not smaller than any value, like for std::lower_bound
+  const auto index = EytzingerIndex<float>{{1.0f, 2.0f, 3.0f}};
+  EXPECT_EQ(index.lower_bound(std::nanf("")), 0u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,84 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/frame_of_reference_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrameOfReferenceSegmentTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ValueSegment<int32_t>> vc_int = std::make_shared<ValueSegment<int32_t>>();
+  std::shared_ptr<ValueSegment<int64_t>> vc_long = std::make_shared<ValueSegment<int64_t>>();
+};
+
+TEST_F(StorageFrameOfReferenceSegmentTest, CompressSegment) {
+  // Values within a block differ by less than 512, so 9 bits suffice even though the values are large
+  for (int32_t i = 0; i < 3000; ++i) vc_int->append(1000000 * (i / 1024) + (i * 7) % 500 - 250);
+
+  auto for_col = std::make_shared<FrameOfReferenceSegment<int32_t>>(vc_int);
+
+  EXPECT_EQ(for_col->size(), 3000u);
+  EXPECT_EQ(for_col->block_count(), 3u);
+  EXPECT_EQ(for_col->offsets()->bit_width(), 9u);
+  EXPECT_EQ(for_col->minimum_of(1), 1000000 - 250);
+
+  auto decoded = std::vector<int32_t>(FrameOfReferenceSegment<int32_t>::block_size);
+  for_col->decode_block(2, decoded.data());
+  for (int32_t i = 0; i < 3000; ++i) {
+    const auto expected = 1000000 * (i / 1024) + (i * 7) % 500 - 250;
+    EXPECT_EQ(for_col->get(i), expected);
+    if (i >= 2048) EXPECT_EQ(decoded[i - 2048], expected);
+  }
+  EXPECT_EQ((*for_col)[5], AllTypeVariant{-215});
+  EXPECT_THROW(for_col->append(1), std::exception);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, FullRange) {
+  vc_long->append(std::numeric_limits<int64_t>::max());
+  vc_long->append(std::numeric_limits<int64_t>::min());
+  vc_long->append(0);
+
+  auto for_col = std::make_shared<FrameOfReferenceSegment<int64_t>>(vc_long);
+
+  EXPECT_EQ(for_col->offsets()->bit_width(), 64u);
+  EXPECT_EQ(for_col->get(0), std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(for_col->get(1), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(for_col->get(2), 0);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, Delta) {
+  // Increasing timestamps with small gaps only need the bits of the largest gap
+  for (int64_t i = 0; i < 2000; ++i) vc_long->append(1546300800000 + i * 3 + i % 2);
+
+  auto for_col = std::make_shared<FrameOfReferenceSegment<int64_t>>(vc_long, true);
+
+  EXPECT_TRUE(for_col->is_delta());
+  EXPECT_EQ(for_col->offsets()->bit_width(), 3u);
+
+  auto decoded = std::vector<int64_t>(FrameOfReferenceSegment<int64_t>::block_size);
+  for_col->decode_block(1, decoded.data());
+  for (int64_t i = 0; i < 2000; ++i) {
+    EXPECT_EQ(for_col->get(i), 1546300800000 + i * 3 + i % 2);
+    if (i >= 1024) EXPECT_EQ(decoded[i - 1024], 1546300800000 + i * 3 + i % 2);
+  }
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, EncodeSegment) {
+  vc_int->append(3);
+  vc_int->append(1);
+
+  EXPECT_TRUE(std::dynamic_pointer_cast<FrameOfReferenceSegment<int32_t>>(
+      encode_segment("int", vc_int, {EncodingType::FrameOfReference})));
+  EXPECT_THROW(encode_segment("int", vc_int, {EncodingType::FrameOfReferenceDelta}), std::logic_error);
+  EXPECT_THROW(encode_segment("string", std::make_shared<ValueSegment<std::string>>(),
+                              {EncodingType::FrameOfReference}),
+               std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/bit_packed_attribute_vector.hpp"
+#include "../../lib/storage/dictionary_segment.hpp"
+#include "../../lib/storage/front_coded_dictionary.hpp"
+#include "../../lib/storage/front_coded_dictionary_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrontCodedDictionarySegmentTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // 100 URLs with long common prefixes, i.e., more than one block, and a prefix of another string
+    for (int index = 0; index < 100; ++index) {
+      urls.emplace_back("https://example.com/products/" + std::to_string(1000 + index * 7));
+    }
+    urls.emplace_back("https://example.com/products/");
+    std::sort(urls.begin(), urls.end());
+  }
+
+  std::vector<std::string> urls;
+};
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, Dictionary) {
+  const auto dictionary = FrontCodedDictionary{urls};
+  ASSERT_EQ(dictionary.size(), urls.size());
+  EXPECT_EQ(dictionary.block_count(), 7u);
+  for (size_t index = 0; index < urls.size(); ++index) {
+    EXPECT_EQ(dictionary.get(index), urls[index]);
+  }
+
+  // The dictionary is much smaller than the strings
+  auto character_count = size_t{0};
+  for (const auto& url : urls) character_count += url.size();
+  EXPECT_LT(dictionary.data_size(), character_count / 3);
+
+  // Blocks are decoded into the same strings one after another, the last block is shorter
+  auto block = std::vector<std::string>{};
+  for (size_t block_index = 0; block_index < dictionary.block_count(); ++block_index) {
+    dictionary.decode_block(block_index, block);
+    ASSERT_EQ(block.size(), std::min(FrontCodedDictionary::block_size, urls.size() - block_index * 16));
+    for (size_t index = 0; index < block.size(); ++index) {
+      EXPECT_EQ(block[index], urls[block_index * 16 + index]);
+    }
+  }
+
+  // The dictionary points into its buffers, which a copy would not own, but a moved dictionary does
+  EXPECT_FALSE(std::is_copy_constructible_v<FrontCodedDictionary>);
+  auto moved_from = FrontCodedDictionary{urls};
+  const auto moved_to = std::move(moved_from);
+  EXPECT_EQ(moved_to.get(50), urls[50]);
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, Bounds) {
+  const auto dictionary = FrontCodedDictionary{urls};
+  // Probe every string, the gaps between them, and values before and after all of them
+  auto probes = urls;
+  for (const auto& url : urls) probes.emplace_back(url + "0");
+  probes.emplace_back("");
+  probes.emplace_back("a");
+  probes.emplace_back("z");
+  for (const auto& probe : probes) {
+    const auto expected_lower = std::lower_bound(urls.cbegin(), urls.cend(), probe) - urls.cbegin();
+    const auto expected_upper = std::upper_bound(urls.cbegin(), urls.cend(), probe) - urls.cbegin();
+    EXPECT_EQ(dictionary.lower_bound(probe), static_cast<size_t>(expected_lower)) << probe;
+    EXPECT_EQ(dictionary.upper_bound(probe), static_cast<size_t>(expected_upper)) << probe;
+  }
+
+  const auto empty_dictionary = FrontCodedDictionary{std::vector<std::string>{}};
+  EXPECT_EQ(empty_dictionary.size(), 0u);
+  EXPECT_EQ(empty_dictionary.lower_bound("a"), 0u);
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, LongStrings) {
+  // Lengths of 128 characters and more take more than one byte
+  const auto strings = std::vector<std::string>{std::string(300, 'a'), std::string(300, 'a') + std::string(200, 'b'),
+                                                std::string(128, 'c')};
+  const auto dictionary = FrontCodedDictionary{strings};
+  for (size_t index = 0; index < strings.size(); ++index) {
+    EXPECT_EQ(dictionary.get(index), strings[index]);
+  }
+  EXPECT_EQ(dictionary.lower_bound(std::string(300, 'a') + "b"), 1u);
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, Segment) {
+  auto value_segment = std::make_shared<ValueSegment<std::string>>();
+  for (int row = 0; row < 1000; ++row) value_segment->append(urls[(row * 13) % urls.size()]);
+
+  auto segment = FrontCodedDictionarySegment{value_segment};
+  const auto dictionary_segment = DictionarySegment<std::string>{value_segment};
+  ASSERT_EQ(segment.size(), 1000u);
+  EXPECT_EQ(segment.unique_values_count(), urls.size());
+  for (size_t row = 0; row < segment.size(); ++row) {
+    EXPECT_EQ(segment.get(row), value_segment->values()[row]);
+    EXPECT_EQ(segment.attribute_vector()->get(row), dictionary_segment.attribute_vector()->get(row));
+  }
+  EXPECT_EQ(type_cast<std::string>(segment[3]), value_segment->values()[3]);
+  EXPECT_EQ(segment.value_by_value_id(ValueID{5}), urls[5]);
+
+  EXPECT_EQ(segment.lower_bound(urls[10]), ValueID{10});
+  EXPECT_EQ(segment.upper_bound(urls[10]), ValueID{11});
+  EXPECT_EQ(segment.lower_bound(AllTypeVariant{"zzz"}), INVALID_VALUE_ID);
+  EXPECT_EQ(segment.upper_bound(urls.back()), INVALID_VALUE_ID);
+  EXPECT_THROW(segment.append("a"), std::exception);
+
+  EXPECT_LT(segment.estimate_memory_usage(), dictionary_segment.estimate_memory_usage());
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, Encode) {
+  auto value_segment = std::make_shared<ValueSegment<std::string>>();
+  for (const auto& url : urls) value_segment->append(url);
+
+  const auto segment = encode_segment("string", value_segment, {EncodingType::FrontCodedDictionary});
+  EXPECT_EQ(segment_encoding_name("string", segment), "FrontCodedDictionary");
+  const auto bit_packed_segment = encode_segment(
+      "string", value_segment, {EncodingType::FrontCodedDictionary, VectorCompressionType::BitPacked});
+  EXPECT_EQ(segment_encoding_name("string", bit_packed_segment), "FrontCodedDictionary (BitPacked)");
+  EXPECT_EQ(type_cast<std::string>((*bit_packed_segment)[7]), urls[7]);
+
+  auto int_segment = std::make_shared<ValueSegment<int>>();
+  int_segment->append(1);
+  EXPECT_THROW(encode_segment("int", int_segment, {EncodingType::FrontCodedDictionary}), std::exception);
+}
+
+}  // namespace opossum
@@ -0,0 +1,79 @@
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/gorilla_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageGorillaSegmentTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ValueSegment<float>> vc_float = std::make_shared<ValueSegment<float>>();
+  std::shared_ptr<ValueSegment<double>> vc_double = std::make_shared<ValueSegment<double>>();
+};
+
+TEST_F(StorageGorillaSegmentTest, CompressSlowlyChangingValues) {
+  // A slowly changing sensor reading with repeated values
+  for (int i = 0; i < 2500; ++i) vc_double->append(20.0 + (i / 4) * 0.25);
+
+  auto gorilla_col = std::make_shared<GorillaSegment<double>>(vc_double);
+
+  EXPECT_EQ(gorilla_col->size(), 2500u);
+  EXPECT_EQ(gorilla_col->block_count(), 3u);
+  EXPECT_LT(gorilla_col->compressed_bit_count(), 2500u * 64 / 4);
+
+  auto decoded = std::vector<double>(GorillaSegment<double>::block_size);
+  gorilla_col->decode_block(2, decoded.data());
+  for (int i = 0; i < 2500; ++i) {
+    EXPECT_EQ(gorilla_col->get(i), 20.0 + (i / 4) * 0.25);
+    if (i >= 2048) EXPECT_EQ(decoded[i - 2048], 20.0 + (i / 4) * 0.25);
+  }
+  EXPECT_EQ((*gorilla_col)[5], AllTypeVariant{20.25});
+  EXPECT_THROW(gorilla_col->append(1.0), std::exception);
+}
+
+TEST_F(StorageGorillaSegmentTest, Lossless) {
+  const auto special_values = std::vector<float>{0.0f,
+                                                 -0.0f,
+                                                 std::numeric_limits<float>::infinity(),
+                                                 -std::numeric_limits<float>::infinity(),
+                                                 std::numeric_limits<float>::denorm_min(),
+                                                 std::numeric_limits<float>::max(),
+                                                 std::numeric_limits<float>::lowest()};
+  for (const auto value : special_values) vc_float->append(value);
+  for (int i = 0; i < 1500; ++i) vc_float->append(std::sin(static_cast<float>(i)) * 1000.0f);
+  vc_float->append(std::nanf(""));
+
+  auto gorilla_col = std::make_shared<GorillaSegment<float>>(vc_float);
+
+  const auto& values = vc_float->values();
+  for (size_t i = 0; i < values.size() - 1; ++i) {
+    EXPECT_EQ(gorilla_col->get(i), values[i]);
+    EXPECT_EQ(std::signbit(gorilla_col->get(i)), std::signbit(values[i]));
+  }
+  EXPECT_TRUE(std::isnan(gorilla_col->get(values.size() - 1)));
+}
+
+TEST_F(StorageGorillaSegmentTest, Empty) {
+  auto gorilla_col = std::make_shared<GorillaSegment<double>>(vc_double);
+
+  EXPECT_EQ(gorilla_col->size(), 0u);
+  EXPECT_EQ(gorilla_col->block_count(), 0u);
+}
+
+TEST_F(StorageGorillaSegmentTest, EncodeSegment) {
+  vc_double->append(1.5);
+
+  EXPECT_TRUE(std::dynamic_pointer_cast<GorillaSegment<double>>(
+      encode_segment("double", vc_double, {EncodingType::Gorilla})));
+  EXPECT_THROW(encode_segment("int", std::make_shared<ValueSegment<int32_t>>(), {EncodingType::Gorilla}),
+               std::logic_error);
+}
+
+}  // namespace opossum
@@ -92,4 +92,23 @@ TEST_F(ReferenceSegmentTest, RetrievesValuesFromChunks) {
   EXPECT_EQ(reference_segment[2], column_2[1]);
 }
 
+TEST_F(ReferenceSegmentTest, RetrievesValuesFromSingleChunkPosList) {
+  auto pos_list = std::make_shared<SingleChunkPosList>(SingleChunkPosList{ChunkID{1}, {1, 0}});
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{1}, pos_list);
+
+  auto& column = *(_test_table->get_chunk(ChunkID{1}).get_segment(ColumnID{1}));
+
+  EXPECT_EQ(reference_segment.size(), 2u);
+  EXPECT_EQ(reference_segment[0], column[1]);
+  EXPECT_EQ(reference_segment[1], column[0]);
+  EXPECT_EQ(reference_segment.single_chunk_pos_list(), pos_list);
+  EXPECT_FALSE(reference_segment.pos_list());
+
+  // The offsets take half the memory of RowIDs
+  const auto row_id_segment = ReferenceSegment(
+      _test_table, ColumnID{1}, std::make_shared<PosList>(PosList{RowID{ChunkID{1}, 1}, RowID{ChunkID{1}, 0}}));
+  EXPECT_EQ(reference_segment.estimate_memory_usage() - sizeof(ReferenceSegment) - sizeof(SingleChunkPosList),
+            (row_id_segment.estimate_memory_usage() - sizeof(ReferenceSegment)) / 2);
+}
+
 }  // namespace opossum
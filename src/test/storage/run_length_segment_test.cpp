@@ -0,0 +1,63 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/resolve_type.hpp"
+#include "../../lib/storage/run_length_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageRunLengthSegmentTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
+  std::shared_ptr<ValueSegment<std::string>> vc_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageRunLengthSegmentTest, CompressSegmentString) {
+  for (const auto& value : {"Bill", "Bill", "Steve", "Alexander", "Alexander", "Alexander", "Bill"}) {
+    vc_str->append(value);
+  }
+
+  auto col = make_shared_by_data_type<BaseSegment, RunLengthSegment>("string", vc_str);
+  auto rle_col = std::dynamic_pointer_cast<RunLengthSegment<std::string>>(col);
+
+  EXPECT_EQ(rle_col->size(), 7u);
+  EXPECT_EQ(rle_col->run_count(), 4u);
+  EXPECT_EQ(*rle_col->values(), (std::vector<std::string>{"Bill", "Steve", "Alexander", "Bill"}));
+  EXPECT_EQ(*rle_col->end_positions(), (std::vector<ChunkOffset>{1, 2, 5, 6}));
+}
+
+TEST_F(StorageRunLengthSegmentTest, Get) {
+  for (int i = 0; i < 20; ++i) vc_int->append(i / 3);
+
+  auto rle_col = std::make_shared<RunLengthSegment<int>>(vc_int);
+
+  EXPECT_EQ(rle_col->run_count(), 7u);
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(rle_col->get(i), i / 3);
+    EXPECT_EQ((*rle_col)[i], AllTypeVariant{i / 3});
+  }
+  EXPECT_THROW(rle_col->append(0), std::exception);
+}
+
+TEST_F(StorageRunLengthSegmentTest, Empty) {
+  auto rle_col = std::make_shared<RunLengthSegment<int>>(vc_int);
+
+  EXPECT_EQ(rle_col->size(), 0u);
+  EXPECT_EQ(rle_col->run_count(), 0u);
+}
+
+TEST_F(StorageRunLengthSegmentTest, EncodeSegment) {
+  vc_int->append(4);
+  vc_int->append(4);
+
+  const auto segment = encode_segment("int", vc_int, {EncodingType::RunLength});
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<int>>(segment));
+  EXPECT_EQ(encode_segment("int", vc_int, {EncodingType::Unencoded}), vc_int);
+}
+
+}  // namespace opossum
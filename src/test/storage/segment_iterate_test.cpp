@@ -0,0 +1,153 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/contiguous_string_segment.hpp"
+#include "../../lib/storage/reference_segment.hpp"
+#include "../../lib/storage/segment_encoding_utils.hpp"
+#include "../../lib/storage/segment_iterate.hpp"
+#include "../../lib/storage/table.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageSegmentIterateTest : public ::testing::Test {
+ protected:
+  // Collects the values of a segment as T
+  template <typename T>
+  std::vector<T> iterate(const BaseSegment& segment) {
+    auto values = std::vector<T>{};
+    segment_iterate<T>(segment, [&](const auto& value) { values.emplace_back(T{value}); });
+    return values;
+  }
+};
+
+TEST_F(StorageSegmentIterateTest, EncodedIntSegments) {
+  // More than one block of the frame-of-reference encodings, sorted for the delta variant, with runs for the run-length
+  // encoding
+  auto expected = std::vector<int32_t>{};
+  for (int32_t row = 0; row < 2500; ++row) expected.emplace_back(row / 3 - 20);
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  value_segment->append_values(expected.data(), expected.size());
+  EXPECT_EQ(iterate<int32_t>(*value_segment), expected);
+
+  for (const auto encoding_type : {EncodingType::Dictionary, EncodingType::RunLength, EncodingType::FrameOfReference,
+                                   EncodingType::FrameOfReferenceDelta}) {
+    for (const auto vector_compression :
+         {VectorCompressionType::FixedSizeByteAligned, VectorCompressionType::BitPacked}) {
+      const auto segment = encode_segment("int", value_segment, {encoding_type, vector_compression});
+      EXPECT_EQ(iterate<int32_t>(*segment), expected) << segment_encoding_name("int", segment);
+    }
+  }
+}
+
+TEST_F(StorageSegmentIterateTest, EncodedFloatSegments) {
+  auto expected = std::vector<double>{};
+  for (int row = 0; row < 1500; ++row) expected.emplace_back(row * 0.25);
+  auto value_segment = std::make_shared<ValueSegment<double>>();
+  value_segment->append_values(expected.data(), expected.size());
+
+  for (const auto encoding_type : {EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::Gorilla}) {
+    const auto segment = encode_segment("double", value_segment, {encoding_type});
+    EXPECT_EQ(iterate<double>(*segment), expected) << segment_encoding_name("double", segment);
+  }
+}
+
+TEST_F(StorageSegmentIterateTest, StringSegments) {
+  const auto expected = std::vector<std::string>{"b", "a", "", "b", "a long string", "c"};
+  auto value_segment = std::make_shared<ValueSegment<std::string>>();
+  for (const auto& value : expected) value_segment->append(value);
+
+  const auto contiguous_segment = ContiguousStringSegment{ValueSpan<std::string>{expected}};
+  EXPECT_EQ(iterate<std::string>(contiguous_segment), expected);
+  for (const auto encoding_type :
+       {EncodingType::Dictionary, EncodingType::FrontCodedDictionary, EncodingType::RunLength}) {
+    const auto segment = encode_segment("string", value_segment, {encoding_type});
+    EXPECT_EQ(iterate<std::string>(*segment), expected) << segment_encoding_name("string", segment);
+  }
+}
+
+TEST_F(StorageSegmentIterateTest, ReferenceSegment) {
+  auto table = std::make_shared<Table>(4);
+  table->add_column("a", "int");
+  for (int row = 0; row < 10; ++row) table->append({row * 10});
+  table->compress_chunk(ChunkID{1});
+
+  // Positions in the value segments of chunks 0 and 2 and in the dictionary segment of chunk 1, not in order
+  const auto pos_list = std::make_shared<PosList>(PosList{{ChunkID{2}, 1},
+                                                          {ChunkID{0}, 3},
+                                                          {ChunkID{0}, 0},
+                                                          {ChunkID{1}, 2},
+                                                          {ChunkID{1}, 2},
+                                                          {ChunkID{2}, 0}});
+  const auto reference_segment = ReferenceSegment{table, ColumnID{0}, pos_list};
+  EXPECT_EQ(iterate<int32_t>(reference_segment), (std::vector<int32_t>{90, 30, 0, 60, 60, 80}));
+
+  const auto single_chunk_pos_list = std::make_shared<SingleChunkPosList>(SingleChunkPosList{ChunkID{1}, {3, 0, 2}});
+  const auto single_chunk_segment = ReferenceSegment{table, ColumnID{0}, single_chunk_pos_list};
+  EXPECT_EQ(iterate<int32_t>(single_chunk_segment), (std::vector<int32_t>{70, 40, 60}));
+
+  const auto empty_segment = ReferenceSegment{table, ColumnID{0}, std::make_shared<PosList>()};
+  EXPECT_TRUE(iterate<int32_t>(empty_segment).empty());
+}
+
+TEST_F(StorageSegmentIterateTest, ReferenceSegmentOnEncodedSegments) {
+  // Positions within one block, in the next block, and back in the first one
+  const auto chunk_offsets = std::vector<ChunkOffset>{0, 5, 17, 1023, 1024, 2000, 2499, 3, 1500};
+  const auto referenced_values = [&](const std::string& type, const AllTypeValueSpan& values,
+                                     const SegmentEncodingSpec& spec) {
+    auto table = std::make_shared<Table>(0);
+    table->add_column("a", type);
+    table->append_columns({values});
+    table->compress_chunk(ChunkID{0}, spec);
+    return std::make_shared<ReferenceSegment>(
+        table, ColumnID{0}, std::make_shared<SingleChunkPosList>(SingleChunkPosList{ChunkID{0}, chunk_offsets}));
+  };
+
+  auto ints = std::vector<int32_t>{};
+  auto doubles = std::vector<double>{};
+  auto strings = std::vector<std::string>{};
+  for (int32_t row = 0; row < 2500; ++row) {
+    ints.emplace_back(row / 3 - 20);
+    doubles.emplace_back(row * 0.25);
+    strings.emplace_back("https://example.com/" + std::to_string(row % 700));
+  }
+
+  auto expected_ints = std::vector<int32_t>{};
+  auto expected_doubles = std::vector<double>{};
+  auto expected_strings = std::vector<std::string>{};
+  for (const auto chunk_offset : chunk_offsets) {
+    expected_ints.emplace_back(ints[chunk_offset]);
+    expected_doubles.emplace_back(doubles[chunk_offset]);
+    expected_strings.emplace_back(strings[chunk_offset]);
+  }
+
+  for (const auto encoding_type : {EncodingType::FrameOfReference, EncodingType::FrameOfReferenceDelta}) {
+    EXPECT_EQ(iterate<int32_t>(*referenced_values("int", ValueSpan<int32_t>{ints}, {encoding_type})), expected_ints);
+  }
+  EXPECT_EQ(iterate<double>(*referenced_values("double", ValueSpan<double>{doubles}, {EncodingType::Gorilla})),
+            expected_doubles);
+  for (const auto encoding_type : {EncodingType::Dictionary, EncodingType::FrontCodedDictionary}) {
+    EXPECT_EQ(iterate<std::string>(*referenced_values("string", ValueSpan<std::string>{strings}, {encoding_type})),
+              expected_strings);
+  }
+}
+
+TEST_F(StorageSegmentIterateTest, ResolveSegmentType) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  value_segment->append(1);
+  const auto dictionary_segment = encode_segment("int", value_segment, {EncodingType::Dictionary});
+
+  auto is_dictionary_segment = false;
+  resolve_segment_type<int32_t>(*dictionary_segment, [&](const auto& typed_segment) {
+    is_dictionary_segment = std::is_same_v<std::decay_t<decltype(typed_segment)>, DictionarySegment<int32_t>>;
+  });
+  EXPECT_TRUE(is_dictionary_segment);
+
+  // The segment does not hold values of the given type
+  EXPECT_THROW(resolve_segment_type<int64_t>(*value_segment, [](const auto&) {}), std::exception);
+}
+
+}  // namespace opossum
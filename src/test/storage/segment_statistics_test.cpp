@@ -0,0 +1,92 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../../lib/storage/segment_statistics.hpp"
+#include "../../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageSegmentStatisticsTest : public ::testing::Test {};
+
+TEST_F(StorageSegmentStatisticsTest, MinMax) {
+  const auto statistics = SegmentStatistics<int>{{5, 3, 9, 4}};
+  EXPECT_TRUE(statistics.has_min_max());
+  EXPECT_EQ(statistics.min(), 3);
+  EXPECT_EQ(statistics.max(), 9);
+  EXPECT_EQ(statistics.row_count(), 4u);
+
+  const auto empty_statistics = SegmentStatistics<std::string>{{}};
+  EXPECT_FALSE(empty_statistics.has_min_max());
+  EXPECT_EQ(empty_statistics.match<ScanType::OpNotEquals>("a"), PredicateMatch::None);
+}
+
+TEST_F(StorageSegmentStatisticsTest, Match) {
+  const auto statistics = SegmentStatistics<int>{{5, 3, 9, 4}};
+
+  EXPECT_EQ(statistics.match<ScanType::OpEquals>(2), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpEquals>(4), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpNotEquals>(10), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpNotEquals>(9), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThan>(3), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThan>(10), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThan>(9), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThanEquals>(2), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThanEquals>(9), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThan>(9), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThan>(2), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThan>(3), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThanEquals>(10), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThanEquals>(3), PredicateMatch::All);
+
+  const auto constant_statistics = SegmentStatistics<int>{{7, 7}};
+  EXPECT_EQ(constant_statistics.match<ScanType::OpEquals>(7), PredicateMatch::All);
+  EXPECT_EQ(constant_statistics.match<ScanType::OpNotEquals>(7), PredicateMatch::None);
+}
+
+TEST_F(StorageSegmentStatisticsTest, NaN) {
+  const auto nan = std::numeric_limits<float>::quiet_NaN();
+  const auto statistics = SegmentStatistics<float>{{1.0f, nan, 2.0f}};
+  EXPECT_EQ(statistics.min(), 1.0f);
+  EXPECT_EQ(statistics.max(), 2.0f);
+
+  // NaN rows do not satisfy a comparison, except for OpNotEquals
+  EXPECT_EQ(statistics.match<ScanType::OpLessThan>(5.0f), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpGreaterThan>(5.0f), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpNotEquals>(5.0f), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpEquals>(nan), PredicateMatch::Some);
+
+  const auto nan_statistics = SegmentStatistics<float>{{nan, nan}};
+  EXPECT_FALSE(nan_statistics.has_min_max());
+  EXPECT_EQ(nan_statistics.match<ScanType::OpEquals>(1.0f), PredicateMatch::None);
+  EXPECT_EQ(nan_statistics.match<ScanType::OpNotEquals>(1.0f), PredicateMatch::All);
+}
+
+TEST_F(StorageSegmentStatisticsTest, BloomFilter) {
+  const auto statistics = SegmentStatistics<int>{{10, 20, 30, 40}, 16};
+  ASSERT_TRUE(statistics.bloom_filter());
+  EXPECT_EQ(statistics.match<ScanType::OpEquals>(30), PredicateMatch::Some);
+  EXPECT_EQ(statistics.match<ScanType::OpEquals>(25), PredicateMatch::None);
+  EXPECT_EQ(statistics.match<ScanType::OpNotEquals>(25), PredicateMatch::All);
+  EXPECT_EQ(statistics.match<ScanType::OpLessThan>(25), PredicateMatch::Some);
+
+  EXPECT_FALSE((SegmentStatistics<int>{{10, 20}}.bloom_filter()));
+}
+
+TEST_F(StorageSegmentStatisticsTest, CreateFromValueSegment) {
+  auto value_segment = std::make_shared<ValueSegment<std::string>>();
+  value_segment->append("Bill");
+  value_segment->append("Alexander");
+  value_segment->append("Steve");
+
+  const auto statistics = std::dynamic_pointer_cast<SegmentStatistics<std::string>>(
+      create_segment_statistics("string", value_segment));
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(statistics->min(), "Alexander");
+  EXPECT_EQ(statistics->max(), "Steve");
+}
+
+}  // namespace opossum
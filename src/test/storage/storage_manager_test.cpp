@@ -1,4 +1,8 @@
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -50,4 +54,97 @@ TEST_F(StorageStorageManagerTest, HasTable) {
   EXPECT_EQ(sm.has_table("first_table"), true);
 }
 
+TEST_F(StorageStorageManagerTest, MemoryUsage) {
+  auto& sm = StorageManager::get();
+  const auto table = sm.get_table("second_table");
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  for (auto row = 0; row < 10; ++row) {
+    table->append({row, std::to_string(row)});
+  }
+  table->compress_chunk(ChunkID{0});
+  table->compress_chunk(ChunkID{1}, SegmentEncodingSpec{EncodingType::RunLength});
+
+  const auto memory_usage = sm.memory_usage();
+  ASSERT_EQ(memory_usage.size(), 6u);
+  EXPECT_EQ(memory_usage[0].table_name, "second_table");
+  EXPECT_EQ(memory_usage[0].column_name, "a");
+  EXPECT_EQ(memory_usage[0].encoding, "Dictionary");
+  EXPECT_EQ(memory_usage[1].encoding, "RunLength");
+  EXPECT_EQ(memory_usage[2].encoding, "Unencoded");
+  EXPECT_EQ(memory_usage[2].segment_count, 1u);
+  EXPECT_EQ(memory_usage[2].row_count, 2u);
+  EXPECT_EQ(memory_usage[5].column_name, "b");
+
+  auto bytes = size_t{0};
+  for (const auto& usage : memory_usage) {
+    bytes += usage.bytes;
+  }
+  EXPECT_EQ(bytes + table->chunk_count() * sizeof(Chunk) + sizeof(Table), table->estimate_memory_usage());
+}
+
+TEST_F(StorageStorageManagerTest, PrintEncodingReport) {
+  auto& sm = StorageManager::get();
+  const auto table = sm.get_table("first_table");
+  table->add_column("a", "int");
+  table->append({1});
+  table->compress_chunk(ChunkID{0}, SegmentEncodingSpec{EncodingType::RunLength});
+
+  std::ostringstream output;
+  sm.print_encoding_report(output);
+  EXPECT_EQ(output.str().rfind("first_table.a, chunk: 0, encoding: RunLength, bytes: ", 0), 0u);
+}
+
+TEST_F(StorageStorageManagerTest, TableOutlivesDrop) {
+  auto& sm = StorageManager::get();
+  const auto table = sm.get_table("second_table");
+  sm.drop_table("second_table");
+  EXPECT_EQ(table->chunk_size(), 4u);
+}
+
+TEST_F(StorageStorageManagerTest, DroppedTableIsFreed) {
+  auto& sm = StorageManager::get();
+  auto table = std::weak_ptr<Table>{sm.get_table("second_table")};
+  sm.drop_table("second_table");
+  EXPECT_TRUE(table.expired());
+}
+
+TEST_F(StorageStorageManagerTest, ConcurrentAccess) {
+  auto& sm = StorageManager::get();
+  auto done = std::atomic<bool>{false};
+
+  // Readers always find the tables that are not dropped, while other tables come and go
+  auto readers = std::vector<std::thread>{};
+  for (auto reader_id = 0; reader_id < 2; ++reader_id) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        ASSERT_TRUE(sm.get_table("first_table"));
+        ASSERT_TRUE(sm.has_table("second_table"));
+        sm.table_names();
+      }
+    });
+  }
+
+  auto writers = std::vector<std::thread>{};
+  for (auto writer_id = 0; writer_id < 2; ++writer_id) {
+    writers.emplace_back([&, writer_id]() {
+      for (auto iteration = 0; iteration < 200; ++iteration) {
+        const auto name = "table_" + std::to_string(writer_id) + "_" + std::to_string(iteration);
+        sm.add_table(name, std::make_shared<Table>());
+        EXPECT_TRUE(sm.has_table(name));
+        sm.drop_table(name);
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(sm.table_names(), (std::vector<std::string>{"first_table", "second_table"}));
+}
+
 }  // namespace opossum
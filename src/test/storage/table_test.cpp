@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -81,4 +85,248 @@ TEST_F(StorageTableTest, CompressChunk) {
   EXPECT_EQ(t.column_count(), 2u);
 }
 
+TEST_F(StorageTableTest, ChunkStatistics) {
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).get_statistics(ColumnID{0}), nullptr);
+
+  // Statistics are created once a chunk is full, and kept when it is compressed
+  t.append({3, "!"});
+  const auto statistics =
+      std::dynamic_pointer_cast<const SegmentStatistics<int>>(t.get_chunk(ChunkID{0}).get_statistics(ColumnID{0}));
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(statistics->min(), 4);
+  EXPECT_EQ(statistics->max(), 6);
+  EXPECT_EQ(t.get_chunk(ChunkID{1}).get_statistics(ColumnID{0}), nullptr);
+
+  t.compress_chunk(ChunkID{1});
+  const auto compressed_statistics = std::dynamic_pointer_cast<const SegmentStatistics<std::string>>(
+      t.get_chunk(ChunkID{1}).get_statistics(ColumnID{1}));
+  ASSERT_TRUE(compressed_statistics);
+  EXPECT_EQ(compressed_statistics->min(), "!");
+}
+
+TEST_F(StorageTableTest, AutoCompression) {
+  t.set_auto_compression(SegmentEncodingSpec{EncodingType::Dictionary});
+  for (auto row = 0; row < 5; ++row) {
+    t.append({row, std::to_string(row)});
+  }
+  t.wait_for_background_compression();
+
+  // Full chunks are encoded in the background, the chunk that is appended to is not
+  for (ChunkID chunk_id{0}; chunk_id < 2; ++chunk_id) {
+    const auto segment = t.get_chunk(chunk_id).get_segment(ColumnID{1});
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(segment));
+    EXPECT_EQ(type_cast<std::string>((*segment)[1]), std::to_string(chunk_id * 2 + 1));
+  }
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int32_t>>(t.get_chunk(ChunkID{2}).get_segment(ColumnID{0})));
+  EXPECT_EQ(t.row_count(), 5u);
+}
+
+TEST_F(StorageTableTest, ReadDuringCompression) {
+  Table table{1000};
+  table.add_column("col_1", "int");
+  for (auto row = 0; row < 1000; ++row) {
+    table.append({row});
+  }
+
+  // Readers always see a complete segment, either the ValueSegment or the DictionarySegment
+  auto reader = std::thread([&table]() {
+    for (auto iteration = 0; iteration < 1000; ++iteration) {
+      const auto segment = table.get_chunk(ChunkID{0}).get_segment(ColumnID{0});
+      ASSERT_EQ(segment->size(), 1000u);
+      ASSERT_EQ(type_cast<int32_t>((*segment)[999]), 999);
+    }
+  });
+  table.compress_chunk(ChunkID{0});
+  reader.join();
+
+  const auto segment = table.get_chunk(ChunkID{0}).get_segment(ColumnID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment));
+}
+
+TEST_F(StorageTableTest, AppendDuringCompressionOfLastChunk) {
+  for (auto iteration = 0; iteration < 3; ++iteration) {
+    // Chunks of unlimited size are only finished by compressing them or creating a new chunk
+    Table table{0};
+    table.add_column("col_1", "int");
+    table.set_auto_compression(SegmentEncodingSpec{EncodingType::RunLength, VectorCompressionType::BitPacked, 16});
+    auto values = std::vector<int32_t>(50000);
+    std::iota(values.begin(), values.end(), 0);
+    table.append_columns({ValueSpan<int32_t>{values}});
+
+    // The appender finishes the chunk while it is being compressed. Had that encoded the chunk in the background, too,
+    // it would end up run-length encoded.
+    auto compressed = std::atomic<bool>{false};
+    auto appender = std::thread([&]() {
+      auto batch = std::vector<int32_t>(100);
+      for (auto first_row = 50000; !compressed || table.chunk_count() == 1; first_row += 100) {
+        std::iota(batch.begin(), batch.end(), first_row);
+        table.append_columns({ValueSpan<int32_t>{batch}});
+      }
+    });
+    while (table.row_count() == 50000) std::this_thread::yield();
+    table.compress_chunk(ChunkID{0}, {EncodingType::Unencoded, VectorCompressionType::BitPacked, 16});
+    compressed = true;
+    appender.join();
+    table.create_new_chunk();
+    table.wait_for_background_compression();
+
+    const auto report = table.encoding_report();
+    ASSERT_EQ(report.size(), 2u);
+    EXPECT_EQ(report[0].encoding, "Unencoded");
+    EXPECT_EQ(report[1].encoding, "RunLength");
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int32_t>>(table.get_chunk(ChunkID{0}).get_segment(ColumnID{0})));
+    auto row = uint64_t{0};
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto segment = table.get_chunk(chunk_id).get_segment(ColumnID{0});
+      for (ChunkOffset offset = 0; offset < segment->size(); ++offset, ++row) {
+        ASSERT_EQ(type_cast<int32_t>((*segment)[offset]), static_cast<int32_t>(row));
+      }
+    }
+    EXPECT_EQ(row, table.row_count());
+
+    // The second chunk was encoded in the background
+    EXPECT_THROW(table.compress_chunk(ChunkID{1}), std::exception);
+  }
+}
+
+TEST_F(StorageTableTest, ColumnEncodings) {
+  t.set_column_encoding(ColumnID{1}, SegmentEncodingSpec{EncodingType::Unencoded});
+  EXPECT_FALSE(t.column_encoding(ColumnID{0}));
+  EXPECT_EQ(t.column_encoding(ColumnID{1})->encoding_type, EncodingType::Unencoded);
+  for (auto row = 0; row < 4; ++row) {
+    t.append({row / 2, std::to_string(row)});
+  }
+
+  // The column encoding takes precedence over the encoding of the chunk
+  t.compress_chunk(ChunkID{0}, SegmentEncodingSpec{EncodingType::RunLength});
+  t.set_column_encoding(ColumnID{1}, std::nullopt);
+  t.compress_chunk(ChunkID{1}, SegmentEncodingSpec{EncodingType::Automatic});
+
+  const auto report = t.encoding_report();
+  ASSERT_EQ(report.size(), 4u);
+  EXPECT_EQ(report[0].encoding, "RunLength");
+  EXPECT_FALSE(report[0].is_column_override);
+  EXPECT_EQ(report[1].column_id, ColumnID{1});
+  EXPECT_EQ(report[1].encoding, "Unencoded");
+  EXPECT_TRUE(report[1].is_column_override);
+  EXPECT_EQ(report[1].compression_ratio(), 1.0);
+  EXPECT_EQ(report[3].chunk_id, ChunkID{1});
+  EXPECT_EQ(report[3].encoded_bytes, t.get_chunk(ChunkID{1}).get_segment(ColumnID{1})->estimate_memory_usage());
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<std::string>>(t.get_chunk(ChunkID{0}).get_segment(ColumnID{1})));
+}
+
+TEST_F(StorageTableTest, EstimateMemoryUsage) {
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  const auto usage = t.estimate_memory_usage();
+  EXPECT_GT(usage, t.get_chunk(ChunkID{0}).estimate_memory_usage() + t.get_chunk(ChunkID{1}).estimate_memory_usage());
+
+  t.compress_chunk(ChunkID{0});
+  EXPECT_NE(t.estimate_memory_usage(), usage);
+}
+
+TEST_F(StorageTableTest, AppendColumns) {
+  t.append({1, "one"});
+
+  const auto ints = std::vector<int32_t>{2, 3, 4, 5};
+  const auto strings = std::vector<std::string>{"two", "three", "four", "five"};
+  t.append_columns({ValueSpan<int32_t>{ints}, ValueSpan<std::string>{strings}});
+
+  // The first chunk is filled up before new chunks are created
+  EXPECT_EQ(t.row_count(), 5u);
+  EXPECT_EQ(t.chunk_count(), 3u);
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).size(), 2u);
+  EXPECT_EQ(t.get_chunk(ChunkID{2}).size(), 1u);
+  EXPECT_EQ(type_cast<int32_t>((*t.get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[1]), 2);
+  EXPECT_EQ(type_cast<std::string>((*t.get_chunk(ChunkID{1}).get_segment(ColumnID{1}))[1]), "four");
+  EXPECT_EQ(type_cast<int32_t>((*t.get_chunk(ChunkID{2}).get_segment(ColumnID{0}))[0]), 5);
+  EXPECT_TRUE(t.get_chunk(ChunkID{1}).get_statistics(ColumnID{0}));
+
+  // Rows can still be appended one by one afterwards
+  t.append({6, "six"});
+  EXPECT_EQ(t.chunk_count(), 3u);
+  EXPECT_EQ(t.row_count(), 6u);
+}
+
+TEST_F(StorageTableTest, ConcurrentAppends) {
+  Table table{1000};
+  table.add_column("col_1", "int");
+  table.add_column("col_2", "string");
+
+  constexpr auto thread_count = 4;
+  constexpr auto rows_per_thread = 5000;
+  auto done = std::atomic<bool>{false};
+
+  // Readers only see rows that are completely written
+  auto reader = std::thread([&]() {
+    while (!done) {
+      for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+        const auto& chunk = table.get_chunk(chunk_id);
+        const auto size = chunk.size();
+        if (size == 0) continue;
+        const auto value = type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[size - 1]);
+        ASSERT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[size - 1]), std::to_string(value));
+      }
+    }
+  });
+
+  auto writers = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < thread_count; ++thread_id) {
+    writers.emplace_back([&, thread_id]() {
+      // Half of the threads append rows one by one, the others in batches
+      for (auto row = 0; row < rows_per_thread; row += 100) {
+        auto ints = std::vector<int32_t>{};
+        auto strings = std::vector<std::string>{};
+        for (auto value = thread_id * rows_per_thread + row; value < thread_id * rows_per_thread + row + 100; ++value) {
+          ints.emplace_back(value);
+          strings.emplace_back(std::to_string(value));
+          if (thread_id % 2 == 0) table.append({value, std::to_string(value)});
+        }
+        if (thread_id % 2 == 1) table.append_columns({ValueSpan<int32_t>{ints}, ValueSpan<std::string>{strings}});
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+
+  ASSERT_EQ(table.row_count(), uint64_t{thread_count * rows_per_thread});
+  auto seen = std::vector<bool>(thread_count * rows_per_thread);
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    EXPECT_LE(chunk.size(), 1000u);
+    for (ChunkOffset offset = 0; offset < chunk.size(); ++offset) {
+      const auto value = type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[offset]);
+      EXPECT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[offset]), std::to_string(value));
+      seen[value] = true;
+    }
+  }
+  EXPECT_EQ(std::count(seen.cbegin(), seen.cend(), true), thread_count * rows_per_thread);
+}
+
+TEST_F(StorageTableTest, AppendAfterCompression) {
+  t.append({4, "Hello,"});
+  t.compress_chunk(ChunkID{0});
+
+  // The compressed chunk cannot be appended to anymore
+  t.append({6, "world"});
+  EXPECT_EQ(t.chunk_count(), 2u);
+  EXPECT_EQ(t.row_count(), 2u);
+  EXPECT_EQ(type_cast<std::string>((*t.get_chunk(ChunkID{1}).get_segment(ColumnID{1}))[0]), "world");
+}
+
+TEST_F(StorageTableTest, AppendColumnsOfWrongType) {
+  const auto longs = std::vector<int64_t>{1};
+  const auto strings = std::vector<std::string>{"one"};
+  EXPECT_THROW(t.append_columns({ValueSpan<int64_t>{longs}, ValueSpan<std::string>{strings}}), std::exception);
+
+  const auto ints = std::vector<int32_t>{1, 2};
+  EXPECT_THROW(t.append_columns({ValueSpan<int32_t>{ints}, ValueSpan<std::string>{strings}}), std::exception);
+}
+
 }  // namespace opossum
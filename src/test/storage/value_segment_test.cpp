@@ -47,4 +47,26 @@ TEST_F(StorageValueSegmentTest, AddValueOfDifferentType) {
   EXPECT_THROW(double_value_segment.append("Hi"), std::exception);
 }
 
+TEST_F(StorageValueSegmentTest, AppendValues) {
+  const auto values = std::vector<int>{1, 2, 3, 4};
+  int_value_segment.append(0);
+  int_value_segment.reserve(10);
+  int_value_segment.append_values(values.data(), values.size());
+
+  EXPECT_EQ(int_value_segment.values(), (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_GE(int_value_segment.values().capacity(), 10u);
+}
+
+TEST_F(StorageValueSegmentTest, EstimateMemoryUsage) {
+  const auto empty_usage = string_value_segment.estimate_memory_usage();
+  string_value_segment.reserve(2);
+  string_value_segment.append("short");
+  const auto short_usage = string_value_segment.estimate_memory_usage();
+  EXPECT_EQ(short_usage, empty_usage + 2 * sizeof(std::string));
+
+  // Long strings store their characters on the heap
+  string_value_segment.append(std::string(100, 'x'));
+  EXPECT_GE(string_value_segment.estimate_memory_usage(), short_usage + 100);
+}
+
 }  // namespace opossum
@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/contiguous_string_segment.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/utils/load_table.hpp"
+
+namespace opossum {
+
+class LoadTableTest : public BaseTest {
+ protected:
+  void TearDown() override { std::remove(_file_name.c_str()); }
+
+  // writes a table with row_count rows that is large enough to be parsed by several tasks
+  void write_table(const size_t row_count) {
+    std::ofstream file(_file_name);
+    file << "a|b|c|d|e\nint|long|float|double|string\n";
+    for (size_t row = 0; row < row_count; ++row) {
+      file << row << "|" << row * 1000000000l << "|" << row % 100 << ".5|" << row << ".25|row#" << row << "\n";
+    }
+  }
+
+  const std::string _file_name = "load_table_test.tbl";
+};
+
+TEST_F(LoadTableTest, SmallTable) {
+  const auto table = load_table("../src/test/tables/int_float.tbl", 2);
+  EXPECT_EQ(table->column_names(), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(table->column_type(ColumnID{1}), "float");
+  EXPECT_EQ(table->row_count(), 3u);
+  EXPECT_EQ(table->chunk_count(), 2u);
+
+  const auto& segment = table->get_chunk(ChunkID{0}).get_segment(ColumnID{1});
+  EXPECT_EQ(std::dynamic_pointer_cast<ValueSegment<float>>(segment)->values(), (std::vector<float>{458.7f, 456.7f}));
+  EXPECT_EQ(type_cast<int32_t>((*table->get_chunk(ChunkID{1}).get_segment(ColumnID{0}))[0]), 1234);
+}
+
+TEST_F(LoadTableTest, ParallelLoad) {
+  const auto row_count = size_t{50000};
+  write_table(row_count);
+
+  const auto table = load_table(_file_name, 1000);
+  ASSERT_EQ(table->row_count(), row_count);
+  EXPECT_EQ(table->chunk_count(), 50u);
+
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& chunk = table->get_chunk(chunk_id);
+    ASSERT_EQ(chunk.size(), 1000u);
+    EXPECT_TRUE(chunk.get_statistics(ColumnID{0}));
+
+    const auto& a = std::dynamic_pointer_cast<ValueSegment<int32_t>>(chunk.get_segment(ColumnID{0}))->values();
+    const auto& b = std::dynamic_pointer_cast<ValueSegment<int64_t>>(chunk.get_segment(ColumnID{1}))->values();
+    const auto& c = std::dynamic_pointer_cast<ValueSegment<float>>(chunk.get_segment(ColumnID{2}))->values();
+    const auto& d = std::dynamic_pointer_cast<ValueSegment<double>>(chunk.get_segment(ColumnID{3}))->values();
+    const auto e = std::dynamic_pointer_cast<ContiguousStringSegment>(chunk.get_segment(ColumnID{4}))->strings();
+    for (size_t chunk_offset = 0; chunk_offset < chunk.size(); ++chunk_offset) {
+      const auto row = chunk_id * 1000 + chunk_offset;
+      ASSERT_EQ(a[chunk_offset], static_cast<int32_t>(row));
+      ASSERT_EQ(b[chunk_offset], static_cast<int64_t>(row * 1000000000l));
+      ASSERT_EQ(c[chunk_offset], static_cast<float>(row % 100) + 0.5f);
+      ASSERT_EQ(d[chunk_offset], static_cast<double>(row) + 0.25);
+      ASSERT_EQ(e[chunk_offset], "row#" + std::to_string(row));
+    }
+  }
+}
+
+TEST_F(LoadTableTest, CompressChunks) {
+  write_table(2500);
+
+  auto options = LoadTableOptions{};
+  options.chunk_encoding = SegmentEncodingSpec{EncodingType::Dictionary};
+  options.max_parallelism = 2;
+  const auto table = load_table(_file_name, 1000, options);
+
+  // The last chunk is not full yet and stays uncompressed
+  ASSERT_EQ(table->chunk_count(), 3u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      table->get_chunk(ChunkID{1}).get_segment(ColumnID{4})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ContiguousStringSegment>(
+      table->get_chunk(ChunkID{2}).get_segment(ColumnID{4})));
+  EXPECT_EQ(type_cast<std::string>((*table->get_chunk(ChunkID{1}).get_segment(ColumnID{4}))[5]), "row#1005");
+  EXPECT_EQ(table->row_count(), 2500u);
+
+  // Loaded strings are immutable, so appended rows go to a new chunk
+  table->append({1, int64_t{2}, 3.0f, 4.0, "appended"});
+  EXPECT_EQ(table->chunk_count(), 4u);
+}
+
+TEST_F(LoadTableTest, InvalidValue) {
+  {
+    std::ofstream file(_file_name);
+    file << "a|b\nint|string\n1|one\ntwo|two\n";
+  }
+  EXPECT_THROW(load_table(_file_name, 10), std::exception);
+  EXPECT_THROW(load_table("../src/test/tables/does_not_exist.tbl", 10), std::exception);
+}
+
+TEST_F(LoadTableTest, NumberFormats) {
+  {
+    std::ofstream file(_file_name);
+    file << "a|b|c|d\nint|long|float|double\n+5|-7|+1.5|-2.5e3\n0|+9000000000|.25|1e-2\n";
+  }
+  const auto table = load_table(_file_name, 10);
+  const auto& chunk = table->get_chunk(ChunkID{0});
+  EXPECT_EQ(type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[0]), 5);
+  EXPECT_EQ(type_cast<int64_t>((*chunk.get_segment(ColumnID{1}))[0]), -7);
+  EXPECT_EQ(type_cast<int64_t>((*chunk.get_segment(ColumnID{1}))[1]), 9000000000);
+  EXPECT_EQ(type_cast<float>((*chunk.get_segment(ColumnID{2}))[0]), 1.5f);
+  EXPECT_EQ(type_cast<float>((*chunk.get_segment(ColumnID{2}))[1]), 0.25f);
+  EXPECT_EQ(type_cast<double>((*chunk.get_segment(ColumnID{3}))[0]), -2500.0);
+  EXPECT_EQ(type_cast<double>((*chunk.get_segment(ColumnID{3}))[1]), 0.01);
+
+  // Signs without digits, doubled signs, spaces, trailing characters, and values out of range are rejected
+  for (const auto* invalid_row : {"+|1|1|1", "+-5|1|1|1", "1|1| 1.5|1", "1|1|1.5x|1", "1|1|1e39|1", "1|1|1|"}) {
+    {
+      std::ofstream file(_file_name);
+      file << "a|b|c|d\nint|long|float|double\n" << invalid_row << "\n";
+    }
+    EXPECT_THROW(load_table(_file_name, 10), std::exception) << invalid_row;
+  }
+}
+
+TEST_F(LoadTableTest, WrongNumberOfFields) {
+  for (const auto* invalid_row : {"1|one|extra", "1|one|", "1"}) {
+    {
+      std::ofstream file(_file_name);
+      file << "a|b\nint|string\n0|zero\n" << invalid_row << "\n";
+    }
+    EXPECT_THROW(load_table(_file_name, 10), std::exception) << invalid_row;
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/contiguous_string_segment.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/fitted_attribute_vector.hpp"
+#include "../lib/storage/segment_statistics.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/storage/value_segment.hpp"
+#include "../lib/utils/table_snapshot.hpp"
+
+namespace opossum {
+
+class TableSnapshotTest : public BaseTest {
+ protected:
+  void TearDown() override {
+    std::remove(_file_name.c_str());
+    std::remove(_second_file_name.c_str());
+  }
+
+  // Writes and loads the table, and checks that the loaded table has the same contents, segment types, and statistics.
+  // Loaded tables are written again to check that they are preserved, too.
+  std::shared_ptr<Table> round_trip(const Table& table) {
+    write_table_snapshot(table, _file_name);
+    const auto loaded_table = load_table_snapshot(_file_name);
+
+    EXPECT_TABLE_EQ(table, *loaded_table, true);
+    EXPECT_EQ(loaded_table->chunk_size(), table.chunk_size());
+    EXPECT_EQ(loaded_table->column_names(), table.column_names());
+    EXPECT_EQ(loaded_table->chunk_count(), table.chunk_count());
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+        const auto& segment = *table.get_chunk(chunk_id).get_segment(column_id);
+        const auto& loaded_segment = *loaded_table->get_chunk(chunk_id).get_segment(column_id);
+        // Unencoded strings are loaded as ContiguousStringSegments that point into the snapshot
+        if (typeid(segment) == typeid(ValueSegment<std::string>)) {
+          EXPECT_EQ(typeid(ContiguousStringSegment), typeid(loaded_segment));
+        } else {
+          EXPECT_EQ(typeid(segment), typeid(loaded_segment));
+        }
+        EXPECT_EQ(table.get_chunk(chunk_id).get_statistics(column_id) == nullptr,
+                  loaded_table->get_chunk(chunk_id).get_statistics(column_id) == nullptr);
+      }
+    }
+    write_table_snapshot(*loaded_table, _second_file_name);
+    EXPECT_TABLE_EQ(table, *load_table_snapshot(_second_file_name), true);
+    return loaded_table;
+  }
+
+  const std::string _file_name = "table_snapshot_test.bin";
+  const std::string _second_file_name = "table_snapshot_test_2.bin";
+};
+
+TEST_F(TableSnapshotTest, IntegerEncodings) {
+  auto table = Table{1000};
+  table.add_column("a", "int");
+  table.add_column("b", "long");
+  for (int row = 0; row < 5500; ++row) table.append({row / 7, int64_t{row} * 1000});
+
+  table.compress_chunk(ChunkID{0}, {EncodingType::Dictionary, VectorCompressionType::BitPacked});
+  table.compress_chunk(ChunkID{1}, {EncodingType::RunLength});
+  table.compress_chunk(ChunkID{2}, {EncodingType::FrameOfReference});
+  table.compress_chunk(ChunkID{3}, {EncodingType::FrameOfReferenceDelta});
+  table.compress_chunk(ChunkID{4});
+
+  round_trip(table);
+}
+
+TEST_F(TableSnapshotTest, FloatingPointAndStringEncodings) {
+  auto numbers = Table{100};
+  numbers.add_column("a", "float");
+  numbers.add_column("b", "double");
+  for (int row = 0; row < 250; ++row) numbers.append({row * 0.5f, row * 0.25});
+  numbers.compress_chunk(ChunkID{0}, {EncodingType::Gorilla});
+  numbers.compress_chunk(ChunkID{1}, {EncodingType::Dictionary});
+  round_trip(numbers);
+
+  auto strings = Table{100};
+  strings.add_column("a", "string");
+  for (int row = 0; row < 250; ++row) strings.append({"customer#" + std::to_string(row / 3)});
+  strings.compress_chunk(ChunkID{0}, {EncodingType::Dictionary, VectorCompressionType::FixedSizeByteAligned, 10});
+  strings.compress_chunk(ChunkID{1}, {EncodingType::RunLength});
+  strings.compress_chunk(ChunkID{2}, {EncodingType::FrontCodedDictionary, VectorCompressionType::BitPacked});
+  const auto loaded_strings = round_trip(strings);
+
+  const auto statistics = std::dynamic_pointer_cast<const SegmentStatistics<std::string>>(
+      loaded_strings->get_chunk(ChunkID{0}).get_statistics(ColumnID{0}));
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(statistics->min(), "customer#0");
+  EXPECT_EQ(statistics->max(), "customer#9");
+  ASSERT_TRUE(statistics->bloom_filter());
+  EXPECT_EQ(statistics->match<ScanType::OpEquals>("customer#12"), PredicateMatch::Some);
+}
+
+TEST_F(TableSnapshotTest, EmptyTable) {
+  auto table = Table{10};
+  table.add_column("a", "int");
+  table.add_column("b", "string");
+  const auto loaded_table = round_trip(table);
+  EXPECT_EQ(loaded_table->row_count(), 0u);
+}
+
+TEST_F(TableSnapshotTest, AttributeVectorsStayMapped) {
+  auto table = Table{100};
+  table.add_column("a", "int");
+  for (int row = 0; row < 100; ++row) table.append({row % 7});
+  table.compress_chunk(ChunkID{0});
+
+  write_table_snapshot(table, _file_name);
+  const auto loaded_table = load_table_snapshot(_file_name);
+  std::remove(_file_name.c_str());
+
+  // The mapping outlives the file
+  const auto segment =
+      std::dynamic_pointer_cast<DictionarySegment<int>>(loaded_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const FittedAttributeVector<uint8_t>>(segment->attribute_vector()));
+  for (int row = 0; row < 100; ++row) {
+    EXPECT_EQ(segment->get(row), row % 7);
+  }
+}
+
+TEST_F(TableSnapshotTest, InvalidSnapshot) {
+  {
+    std::ofstream file(_file_name);
+    file << "a|b\nint|string\n1|one\n";
+  }
+  EXPECT_THROW(load_table_snapshot(_file_name), std::exception);
+  EXPECT_THROW(load_table_snapshot("does_not_exist.bin"), std::exception);
+}
+
+}  // namespace opossum